@@ -0,0 +1,65 @@
+#ifndef BENCHMARK_INSTANCES_HXX
+#define BENCHMARK_INSTANCES_HXX
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include <lemon/full_graph.h>
+
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <Coordinates.hxx>
+
+namespace Benchmark
+{
+
+// Random instance with the depot as node 0 : nodes are drawn uniformly in a 100 x 100 square, demands in [1, 20],
+// and costs are rounded euclidean distances. The same seed always gives the same instance.
+inline Data::CVRPInstance makeRandomInstance(size_t numberOfNodes, size_t vehicleCapacity, size_t numberOfVehicles, uint32_t seed = 42)
+{
+    lemon::FullGraph graph(static_cast<int>(numberOfNodes));
+    Data::CVRPInstance::DemandMap demands(graph);
+    Data::CVRPInstance::CoordinatesMap coordinates(graph);
+    std::mt19937 randomEngine(seed);
+    std::uniform_real_distribution<double> coordinatePicker(0.0, 100.0);
+    std::uniform_int_distribution<size_t> demandPicker(1, 20);
+    
+    for(int id = 0; id < static_cast<int>(numberOfNodes); ++id)
+    {
+        double x = coordinatePicker(randomEngine);
+        double y = coordinatePicker(randomEngine);
+        coordinates[graph(id)] = Coordinates(x, y);
+        demands[graph(id)] = id == 0 ? 0 : demandPicker(randomEngine);
+    }
+    
+    return Data::CVRPInstance(graph, "random", Data::VehicleData(numberOfVehicles, vehicleCapacity), demands, coordinates,
+                              [](Coordinates lhs, Coordinates rhs)
+                              {
+                                  return std::round(std::hypot(lhs.x - rhs.x, lhs.y - rhs.y));
+                              });
+}
+
+// Deals the customers to the vehicles in turn, which gives balanced but long routes to improve on
+struct RoundRobinCVRPSolver
+{
+    Solver::CVRPSolution solve(const Data::CVRPInstance& instance) const
+    {
+        size_t numberOfVehicles = instance.getNumberOfVehicles();
+        Solver::CVRPSolutionData data(numberOfVehicles);
+        
+        for(size_t id = 0; id < instance.getNumberOfNodes(); ++id)
+        {
+            if(id != static_cast<size_t>(instance.idOfDepot()))
+            {
+                data[id % numberOfVehicles].push_back(instance.getNode(id));
+            }
+        }
+        
+        return {instance, std::move(data)};
+    }
+};
+
+}
+
+#endif // BENCHMARK_INSTANCES_HXX
@@ -0,0 +1,82 @@
+// Time per solution of the full cost evaluation, through CostEvaluationKernel::computeBatch and through the cost
+// processor, on a population of random solutions of 300 nodes and 12 routes. The kernel results are first checked
+// against the cost processor. Build with AVX2=1 to time the AVX2 path of the kernel.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <BenchmarkInstances.hxx>
+#include <CompactRoutes.hxx>
+#include <CostEvaluationKernel.hxx>
+#include <CVRPSolution.hxx>
+
+int main()
+{
+    const size_t numberOfNodes = 300;
+    const size_t numberOfVehicles = 12;
+    const size_t populationSize = 50;
+    
+    auto instance = Benchmark::makeRandomInstance(numberOfNodes, 100, numberOfVehicles);
+    std::mt19937 randomEngine(3);
+    std::vector<Solver::CVRPSolutionData> solutions;
+    std::vector<Solver::CompactRoutes> population;
+    
+    for(size_t solution = 0; solution < populationSize; ++solution)
+    {
+        Solver::CVRPSolutionData data(numberOfVehicles);
+        
+        for(size_t id = 1; id < numberOfNodes; ++id)
+        {
+            data[randomEngine() % numberOfVehicles].push_back(instance.getNode(id));
+        }
+        
+        population.emplace_back(instance, data);
+        solutions.push_back(std::move(data));
+    }
+    
+    Solver::CVRPSolutionCostProcessor costProcessor;
+    std::vector<double> distances(populationSize);
+    std::vector<size_t> excessLoads(populationSize);
+    Solver::CostEvaluationKernel::computeBatch(instance, population.begin(), population.end(), distances.data(), excessLoads.data());
+    
+    for(size_t solution = 0; solution < populationSize; ++solution)
+    {
+        double distance = costProcessor.computeDistance(instance, solutions[solution]);
+        
+        if(std::abs(distance - distances[solution]) > 1e-6 || excessLoads[solution] != costProcessor.computeExcessLoad(instance, solutions[solution]))
+        {
+            std::cerr << "Mismatch on solution " << solution << " : distance " << distances[solution] << " instead of " << distance << std::endl;
+            return 1;
+        }
+    }
+    
+    // The sums keep the evaluations from being optimised away
+    const size_t kernelBatches = 20000;
+    const size_t processorEvaluations = 20000;
+    double sum = 0.0;
+    
+    auto start = std::chrono::steady_clock::now();
+    for(size_t batch = 0; batch < kernelBatches; ++batch)
+    {
+        Solver::CostEvaluationKernel::computeBatch(instance, population.begin(), population.end(), distances.data(), nullptr);
+        sum += distances[batch % populationSize];
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for(size_t evaluation = 0; evaluation < processorEvaluations; ++evaluation)
+    {
+        sum += costProcessor.computeDistance(instance, solutions[evaluation % populationSize]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double kernelTime = std::chrono::duration<double, std::nano>(middle - start).count() / (kernelBatches * populationSize);
+    double processorTime = std::chrono::duration<double, std::nano>(end - middle).count() / processorEvaluations;
+    
+    std::cout << "Kernel : " << kernelTime << " ns/solution" << std::endl;
+    std::cout << "Cost processor : " << processorTime << " ns/solution" << std::endl;
+    std::cout << "(" << sum << ")" << std::endl;
+    
+    return 0;
+}
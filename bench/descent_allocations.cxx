@@ -0,0 +1,66 @@
+// Counts the heap allocations of stochastic descent runs of increasing length, on 200 customers and 25 routes.
+// The setup allocates the same for every run, and the final conversion of the solution once per non empty route, so
+// with allocation free steps the counts stay flat whatever the number of steps. A first run, not reported, fills the
+// per-thread pool of the route arena.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include <BenchmarkInstances.hxx>
+#include <OnePointExtraNeighbourhood.hxx>
+#include <StochasticDescentCVRPSolver.hxx>
+
+namespace
+{
+
+size_t allocations = 0;
+
+}
+
+void* operator new(size_t size)
+{
+    ++allocations;
+    
+    if(void* pointer = std::malloc(size != 0 ? size : 1))
+    {
+        return pointer;
+    }
+    
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+int main()
+{
+    auto instance = Benchmark::makeRandomInstance(201, 100, 25);
+    
+    for(size_t steps : {0, 20000, 200000, 2000000})
+    {
+        Solver::StochasticDescentCVRPSolver<Benchmark::RoundRobinCVRPSolver, Heuristic::OnePointExtraNeighbourhood> solver{{}, steps};
+        solver.setSeed(1);
+        
+        size_t allocationsBefore = allocations;
+        auto start = std::chrono::steady_clock::now();
+        auto solution = solver.solve(instance);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t runAllocations = allocations - allocationsBefore;
+        
+        if(steps != 0)
+        {
+            std::cout << steps << " steps : cost " << solution.computeCost() << ", " << runAllocations << " allocations, " << elapsed << "s" << std::endl;
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Time per insertion of the search for the three cheapest insertions of every customer of a route into the next route,
+// through InsertionEvaluator and through the scalar loop SWAP* used before it, on 1000 customers and routes of 10 to 200
+// customers. The three insertions found by both are checked to be the same. Build with AVX2=1 to time the AVX2 path of
+// the evaluator.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <BenchmarkInstances.hxx>
+#include <InsertionEvaluator.hxx>
+#include <SearchSolution.hxx>
+
+namespace
+{
+
+// Three cheapest insertions, sorted by increasing cost
+struct BestInsertions
+{
+    void add(double cost, size_t position) noexcept
+    {
+        for(size_t rank = 0; rank < 3; ++rank)
+        {
+            if(cost < costs[rank])
+            {
+                std::swap(cost, costs[rank]);
+                std::swap(position, positions[rank]);
+            }
+        }
+    }
+    
+    double costs[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    size_t positions[3] = {0, 0, 0};
+};
+
+}
+
+int main()
+{
+    const size_t numberOfNodes = 1001;
+    
+    for(size_t routeSize : {10, 25, 50, 100, 200})
+    {
+        size_t numberOfRoutes = (numberOfNodes - 1) / routeSize;
+        auto instance = Benchmark::makeRandomInstance(numberOfNodes, 100000, numberOfRoutes);
+        Heuristic::SearchSolution solution{instance, Benchmark::RoundRobinCVRPSolver{}.solve(instance).getData()};
+        std::vector<BestInsertions> scalarInsertions(routeSize);
+        std::vector<BestInsertions> evaluatorInsertions(routeSize);
+        Heuristic::InsertionEvaluator evaluator;
+        
+        // Each size runs about the same number of insertions. The sum keeps them from being optimised away.
+        size_t repetitions = 2000000 / (routeSize * routeSize) + 1;
+        double sum = 0.0;
+        
+        auto start = std::chrono::steady_clock::now();
+        for(size_t repetition = 0; repetition < repetitions; ++repetition)
+        {
+            for(size_t route = 0; route + 1 < numberOfRoutes; ++route)
+            {
+                size_t target = route + 1;
+                std::fill(scalarInsertions.begin(), scalarInsertions.end(), BestInsertions{});
+                
+                for(size_t position = 0; position <= solution.getRouteSize(target); ++position)
+                {
+                    auto previous = solution.predecessorOf(target, position);
+                    auto next = position == solution.getRouteSize(target) ? solution.getDepot() : solution.getCustomer(target, position);
+                    double removedCost = solution.costOf(previous, next);
+                    
+                    for(size_t index = 0; index < solution.getRouteSize(route); ++index)
+                    {
+                        auto customer = solution.getCustomer(route, index);
+                        scalarInsertions[index].add(solution.costOf(previous, customer) + solution.costOf(customer, next) - removedCost, position);
+                    }
+                }
+                
+                sum += scalarInsertions[0].costs[0];
+            }
+        }
+        auto middle = std::chrono::steady_clock::now();
+        for(size_t repetition = 0; repetition < repetitions; ++repetition)
+        {
+            for(size_t route = 0; route + 1 < numberOfRoutes; ++route)
+            {
+                std::fill(evaluatorInsertions.begin(), evaluatorInsertions.end(), BestInsertions{});
+                evaluator.loadRoute(solution, route + 1);
+                
+                for(size_t index = 0; index < solution.getRouteSize(route); ++index)
+                {
+                    BestInsertions& insertions = evaluatorInsertions[index];
+                    evaluator.bestInsertions(solution.getCustomer(route, index), 3, insertions.positions, insertions.costs);
+                }
+                
+                sum += evaluatorInsertions[0].costs[0];
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        
+        // Positions may differ between insertions of equal cost, costs may not
+        for(size_t index = 0; index < routeSize; ++index)
+        {
+            for(size_t rank = 0; rank < 3; ++rank)
+            {
+                if(scalarInsertions[index].costs[rank] != evaluatorInsertions[index].costs[rank])
+                {
+                    std::cerr << "Mismatch on route size " << routeSize << ", customer " << index << ", rank " << rank << " : cost "
+                              << evaluatorInsertions[index].costs[rank] << " instead of " << scalarInsertions[index].costs[rank] << std::endl;
+                    return 1;
+                }
+            }
+        }
+        
+        double insertions = static_cast<double>(repetitions) * (numberOfRoutes - 1) * routeSize * (routeSize + 1);
+        double scalarTime = std::chrono::duration<double, std::nano>(middle - start).count();
+        double evaluatorTime = std::chrono::duration<double, std::nano>(end - middle).count();
+        
+        std::cout << "Routes of " << routeSize << " customers : scalar " << scalarTime / insertions << " ns/insertion, evaluator "
+                  << evaluatorTime / insertions << " ns/insertion, speedup " << scalarTime / evaluatorTime << " (" << sum << ")" << std::endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,75 @@
+#ifndef ACTIVE_CUSTOMER_QUEUE_HXX
+#define ACTIVE_CUSTOMER_QUEUE_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Heuristic
+{
+
+// Work queue of the customers whose surroundings changed since they were last scanned without success.
+// Each customer carries a "don't look" bit, cleared when it is queued, so that it is queued at most once : the queue
+// is a ring buffer holding at most one slot per node, and never allocates once constructed.
+class ActiveCustomerQueue
+{
+    public:
+    using IdType = uint32_t;
+    
+    public:
+    explicit ActiveCustomerQueue(size_t numberOfNodes)
+    : queue_(numberOfNodes),
+      active_(numberOfNodes, 0),
+      head_{0},
+      size_{0}
+    {}
+    
+    ActiveCustomerQueue(const ActiveCustomerQueue&) = default;
+    ActiveCustomerQueue(ActiveCustomerQueue&&) = default;
+    
+    ActiveCustomerQueue& operator=(const ActiveCustomerQueue&) = default;
+    ActiveCustomerQueue& operator=(ActiveCustomerQueue&&) = default;
+    
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return queue_.size(); }
+    bool isActive(IdType customer) const noexcept { return active_[customer] != 0; }
+    
+    void activate(IdType customer) noexcept
+    {
+        if(active_[customer] == 0)
+        {
+            active_[customer] = 1;
+            queue_[(head_ + size_) % queue_.size()] = customer;
+            ++size_;
+        }
+    }
+    
+    // The customer is not active anymore once popped, until one of its neighbours changes
+    IdType pop() noexcept
+    {
+        IdType customer = queue_[head_];
+        head_ = (head_ + 1) % queue_.size();
+        --size_;
+        active_[customer] = 0;
+        return customer;
+    }
+    
+    void clear() noexcept
+    {
+        while(!empty())
+        {
+            pop();
+        }
+    }
+    
+    private:
+    std::vector<IdType> queue_;
+    std::vector<uint8_t> active_;
+    size_t head_;
+    size_t size_;
+};
+
+}
+
+#endif // ACTIVE_CUSTOMER_QUEUE_HXX
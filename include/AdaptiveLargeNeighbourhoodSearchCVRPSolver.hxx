@@ -0,0 +1,207 @@
+#ifndef ADAPTIVE_LARGE_NEIGHBOURHOOD_SEARCH_CVRP_SOLVER_HXX
+#define ADAPTIVE_LARGE_NEIGHBOURHOOD_SEARCH_CVRP_SOLVER_HXX
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include <AdaptiveOperatorSelector.hxx>
+#include <AnytimeSolverSettings.hxx>
+#include <BestSolutionRecorder.hxx>
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <DestroyOperator.hxx>
+#include <GenericAcceptancePolicy.hxx>
+#include <GenericCVRPSolver.hxx>
+#include <RandomEngine.hxx>
+#include <RegretInsertion.hxx>
+#include <SearchSolution.hxx>
+#include <SimulatedAnnealingAcceptance.hxx>
+#include <TimeBudget.hxx>
+
+namespace Solver
+{
+
+// Adaptive large neighbourhood search : each iteration removes between 'minRemovals' and 'maxRemovals' customers from
+// a copy of the current solution with a destroy operator, inserts them back with a repair operator, and the acceptance
+// policy decides whether the search goes on from the repaired solution.
+// Destroy operators are the random, worst, related and route removals, repair operators the greedy, regret-2 and
+// regret-3 insertions, each of both drawn by its own roulette wheel. At each iteration, both operators are rewarded
+// with 'newBestReward' if they found a new best feasible solution, 'betterReward' if the repaired solution is better
+// than the current one, 'acceptedReward' if it is worse but accepted, and nothing otherwise.
+// Both steps work in place on the flat routes of the copy, which never allocates once the first iteration is done.
+// As an iteration costs about a millisecond, the time budget is checked after each one.
+template<class BaseSolver, class AcceptancePolicy = Heuristic::SimulatedAnnealingAcceptance>
+class AdaptiveLargeNeighbourhoodSearchCVRPSolver : public GenericCVRPSolver<AdaptiveLargeNeighbourhoodSearchCVRPSolver<BaseSolver, AcceptancePolicy>>,
+                                                   public AnytimeSolverSettings
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    
+    public:
+    static constexpr size_t defaultMinRemovals = 5;
+    static constexpr size_t defaultMaxRemovals = 40;
+    static constexpr double defaultReactionFactor = 0.1;
+    static constexpr size_t defaultSegmentLength = 100;
+    
+    static constexpr double newBestReward = 33.0;
+    static constexpr double betterReward = 9.0;
+    static constexpr double acceptedReward = 13.0;
+    
+    // Regret level of each repair operator, the first one being the greedy insertion
+    static constexpr size_t numberOfRepairOperators = 3;
+    static constexpr size_t repairRegretLevels[numberOfRepairOperators] = {1, 2, 3};
+    
+    public:
+    AdaptiveLargeNeighbourhoodSearchCVRPSolver(const BaseSolver& baseSolver,
+                                               size_t iterations,
+                                               const AcceptancePolicy& acceptancePolicy = AcceptancePolicy{},
+                                               double wrongCapacityPenalty = CVRPSolutionCostProcessor::defaultWrongCapacityPenalty)
+    : GenericCVRPSolver<AdaptiveLargeNeighbourhoodSearchCVRPSolver>(),
+      AnytimeSolverSettings(1),
+      baseSolver_{baseSolver},
+      iterations_{iterations},
+      acceptancePolicy_{acceptancePolicy},
+      wrongCapacityPenalty_{wrongCapacityPenalty},
+      minRemovals_{defaultMinRemovals},
+      maxRemovals_{defaultMaxRemovals},
+      reactionFactor_{defaultReactionFactor},
+      segmentLength_{defaultSegmentLength},
+      destroyOperator_{},
+      repairOperator_{},
+      destroySelector_{Heuristic::DestroyOperator::numberOfTypes},
+      repairSelector_{numberOfRepairOperators},
+      performedIterations_{0}
+    {}
+    
+    void setAcceptancePolicy(const AcceptancePolicy& acceptancePolicy)
+    {
+        acceptancePolicy_ = acceptancePolicy;
+    }
+    
+    // Policy of the last run, holding its final state
+    const AcceptancePolicy& getAcceptancePolicy() const noexcept
+    {
+        return acceptancePolicy_;
+    }
+    
+    void setDestroyOperator(const Heuristic::DestroyOperator& destroyOperator)
+    {
+        destroyOperator_ = destroyOperator;
+    }
+    
+    const Heuristic::DestroyOperator& getDestroyOperator() const noexcept
+    {
+        return destroyOperator_;
+    }
+    
+    // Bounds of the number of customers removed at each iteration, drawn uniformly, the route removal ignoring them
+    void setRemovals(size_t minRemovals, size_t maxRemovals) noexcept
+    {
+        minRemovals_ = std::max(minRemovals, size_t{1});
+        maxRemovals_ = std::max(maxRemovals, minRemovals_);
+    }
+    
+    size_t getMinRemovals() const noexcept { return minRemovals_; }
+    size_t getMaxRemovals() const noexcept { return maxRemovals_; }
+    
+    // Adaptation of the weights of the destroy and repair operators, see Heuristic::AdaptiveOperatorSelector
+    void setOperatorAdaptation(double reactionFactor, size_t segmentLength = defaultSegmentLength) noexcept
+    {
+        reactionFactor_ = reactionFactor;
+        segmentLength_ = segmentLength;
+    }
+    
+    double getReactionFactor() const noexcept { return reactionFactor_; }
+    size_t getSegmentLength() const noexcept { return segmentLength_; }
+    
+    // Selectors of the last run, holding the final weights of the operators, indexed by Heuristic::DestroyType and
+    // by 'repairRegretLevels'
+    const Heuristic::AdaptiveOperatorSelector& getDestroySelector() const noexcept { return destroySelector_; }
+    const Heuristic::AdaptiveOperatorSelector& getRepairSelector() const noexcept { return repairSelector_; }
+    
+    size_t getPerformedIterations() const noexcept { return performedIterations_; }
+    
+    CVRPSolution solve(const CVRPInstance& instance)
+    {
+        Heuristic::RandomEngine randomEngine = startRandomEngine();
+        
+        auto origSol = baseSolver_.solve(instance);
+        Heuristic::SearchSolution current{instance, origSol.getData()};
+        Heuristic::SearchSolution candidate = current;
+        
+        CVRPSolutionCostProcessor costProcessor{wrongCapacityPenalty_};
+        destroySelector_ = Heuristic::AdaptiveOperatorSelector{Heuristic::DestroyOperator::numberOfTypes, reactionFactor_, segmentLength_};
+        repairSelector_ = Heuristic::AdaptiveOperatorSelector{numberOfRepairOperators, reactionFactor_, segmentLength_};
+        
+        TimeBudget timeBudget = startTimeBudget();
+        BestSolutionRecorder best{instance, getBestSolutionCallback()};
+        best.record(current);
+        
+        std::uniform_int_distribution<size_t> removalsPicker(minRemovals_, maxRemovals_);
+        acceptancePolicy_.start(current.getCost(costProcessor));
+        
+        for(performedIterations_ = 0; performedIterations_ < iterations_ && !timeBudget.isExhausted(); ++performedIterations_)
+        {
+            acceptancePolicy_.update(progressOf(performedIterations_, iterations_, timeBudget));
+            
+            size_t destroyIdx = destroySelector_.select(randomEngine);
+            size_t repairIdx = repairSelector_.select(randomEngine);
+            
+            candidate = current;
+            destroyOperator_.apply(candidate, static_cast<Heuristic::DestroyType>(destroyIdx), removalsPicker(randomEngine), randomEngine);
+            repairOperator_.apply(candidate, repairRegretLevels[repairIdx], costProcessor);
+            
+            double currentCost = current.getCost(costProcessor);
+            double candidateCost = candidate.getCost(costProcessor);
+            double reward = 0.0;
+            
+            if(candidate.getExcessLoad() == current.getExcessLoad())
+            {
+                acceptancePolicy_.observeDelta(candidate.getDistance() - current.getDistance());
+            }
+            
+            if(acceptancePolicy_.accept(currentCost, candidateCost, randomEngine))
+            {
+                reward = candidateCost < currentCost ? betterReward : acceptedReward;
+                std::swap(current, candidate);
+                
+                if(best.record(current))
+                {
+                    reward = newBestReward;
+                }
+            }
+            
+            destroySelector_.reward(destroyIdx, reward);
+            repairSelector_.reward(repairIdx, reward);
+            acceptancePolicy_.endStep(current.getCost(costProcessor));
+        }
+        
+        // Without any feasible solution found within the budget, the current one is the best available
+        if(!best.hasSolution())
+        {
+            return {instance, current.toSolutionData()};
+        }
+        
+        return best.toSolution();
+    }
+    
+    private:
+    BaseSolver baseSolver_;
+    size_t iterations_;
+    AcceptancePolicy acceptancePolicy_;
+    double wrongCapacityPenalty_;
+    size_t minRemovals_;
+    size_t maxRemovals_;
+    double reactionFactor_;
+    size_t segmentLength_;
+    Heuristic::DestroyOperator destroyOperator_;
+    Heuristic::RegretInsertion repairOperator_;
+    Heuristic::AdaptiveOperatorSelector destroySelector_;
+    Heuristic::AdaptiveOperatorSelector repairSelector_;
+    size_t performedIterations_;
+};
+
+}
+
+#endif // ADAPTIVE_LARGE_NEIGHBOURHOOD_SEARCH_CVRP_SOLVER_HXX
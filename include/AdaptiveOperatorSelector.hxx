@@ -0,0 +1,129 @@
+#ifndef ADAPTIVE_OPERATOR_SELECTOR_HXX
+#define ADAPTIVE_OPERATOR_SELECTOR_HXX
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace Heuristic
+{
+
+// Roulette wheel selection of operators, whose weights adapt to their recent success as in ALNS.
+// The search is divided in segments of 'segmentLength' selections. During a segment, each operator accumulates the
+// rewards it was given, and at the end of the segment its weight becomes
+//     w = (1 - reactionFactor) * w + reactionFactor * (rewards / selections)
+// if it was selected at least once. A reaction factor of 0 keeps the weights, and the selection, uniform.
+// No weight goes below 'minimumWeightRatio' times the largest weight, so that no operator is ever starved.
+class AdaptiveOperatorSelector
+{
+    public:
+    static constexpr size_t defaultSegmentLength = 1000;
+    static constexpr double defaultMinimumWeightRatio = 0.05;
+    
+    public:
+    explicit AdaptiveOperatorSelector(size_t numberOfOperators,
+                                      double reactionFactor = 0.0,
+                                      size_t segmentLength = defaultSegmentLength,
+                                      double minimumWeightRatio = defaultMinimumWeightRatio)
+    : reactionFactor_{reactionFactor},
+      segmentLength_{std::max(segmentLength, size_t{1})},
+      minimumWeightRatio_{minimumWeightRatio},
+      weights_(numberOfOperators, 1.0),
+      rewards_(numberOfOperators, 0.0),
+      selections_(numberOfOperators, 0),
+      totalWeight_{static_cast<double>(numberOfOperators)},
+      segmentSelections_{0}
+    {}
+    
+    AdaptiveOperatorSelector(const AdaptiveOperatorSelector&) = default;
+    AdaptiveOperatorSelector(AdaptiveOperatorSelector&&) = default;
+    
+    AdaptiveOperatorSelector& operator=(const AdaptiveOperatorSelector&) = default;
+    AdaptiveOperatorSelector& operator=(AdaptiveOperatorSelector&&) = default;
+    
+    size_t getNumberOfOperators() const noexcept { return weights_.size(); }
+    double getReactionFactor() const noexcept { return reactionFactor_; }
+    size_t getSegmentLength() const noexcept { return segmentLength_; }
+    double getWeight(size_t op) const noexcept { return weights_[op]; }
+    
+    // Probability of the operator being selected in the current segment
+    double getProbability(size_t op) const noexcept
+    {
+        return weights_[op] / totalWeight_;
+    }
+    
+    template<class RandomEngine>
+    size_t select(RandomEngine& randomEngine)
+    {
+        if(segmentSelections_ == segmentLength_)
+        {
+            updateWeights();
+        }
+        
+        double target = std::uniform_real_distribution<double>{0.0, totalWeight_}(randomEngine);
+        size_t op = 0;
+        
+        while(op + 1 < weights_.size() && target >= weights_[op])
+        {
+            target -= weights_[op];
+            ++op;
+        }
+        
+        ++selections_[op];
+        ++segmentSelections_;
+        return op;
+    }
+    
+    // Credits the last selection of the operator with the given reward
+    void reward(size_t op, double value) noexcept
+    {
+        rewards_[op] += value;
+    }
+    
+    private:
+    void updateWeights() noexcept
+    {
+        double maxWeight = 0.0;
+        
+        for(size_t op = 0; op < weights_.size(); ++op)
+        {
+            if(selections_[op] != 0)
+            {
+                weights_[op] = (1.0 - reactionFactor_) * weights_[op] + reactionFactor_ * rewards_[op] / selections_[op];
+            }
+            
+            maxWeight = std::max(maxWeight, weights_[op]);
+            rewards_[op] = 0.0;
+            selections_[op] = 0;
+        }
+        
+        // No operator was rewarded for long enough to wipe out every weight : back to the uniform selection
+        if(maxWeight == 0.0)
+        {
+            std::fill(weights_.begin(), weights_.end(), 1.0);
+            maxWeight = 1.0;
+        }
+        
+        totalWeight_ = 0.0;
+        for(double& weight : weights_)
+        {
+            weight = std::max(weight, minimumWeightRatio_ * maxWeight);
+            totalWeight_ += weight;
+        }
+        
+        segmentSelections_ = 0;
+    }
+    
+    double reactionFactor_;
+    size_t segmentLength_;
+    double minimumWeightRatio_;
+    std::vector<double> weights_;
+    std::vector<double> rewards_;
+    std::vector<size_t> selections_;
+    double totalWeight_;
+    size_t segmentSelections_;
+};
+
+}
+
+#endif // ADAPTIVE_OPERATOR_SELECTOR_HXX
@@ -0,0 +1,120 @@
+#ifndef ANYTIME_SOLVER_SETTINGS_HXX
+#define ANYTIME_SOLVER_SETTINGS_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include <GenericAcceptancePolicy.hxx>
+#include <GenericCVRPSolver.hxx>
+#include <RandomEngine.hxx>
+#include <TimeBudget.hxx>
+
+namespace Solver
+{
+
+// Settings shared by the anytime solvers, which derive from this class : the seed and the stream of their random
+// engine, their time budget, and the callback given each new best feasible solution.
+class AnytimeSolverSettings
+{
+    public:
+    // Number of iterations for runs only bounded by their time budget
+    static constexpr size_t unlimitedIterations = std::numeric_limits<size_t>::max();
+    
+    public:
+    // Solvers whose iterations are long enough to read the clock after each one give a check period of 1
+    explicit AnytimeSolverSettings(size_t timeBudgetCheckPeriod = TimeBudget::defaultCheckPeriod)
+    : seed_{(uint64_t{std::random_device{}()} << 32) | std::random_device{}()},
+      stream_{0},
+      timeBudgetCheckPeriod_{timeBudgetCheckPeriod},
+      timeBudget_{},
+      bestSolutionCallback_{}
+    {}
+    
+    AnytimeSolverSettings(const AnytimeSolverSettings&) = default;
+    AnytimeSolverSettings(AnytimeSolverSettings&&) = default;
+    
+    AnytimeSolverSettings& operator=(const AnytimeSolverSettings&) = default;
+    AnytimeSolverSettings& operator=(AnytimeSolverSettings&&) = default;
+    
+    // The run stops after its number of iterations or once the budget is exhausted, whichever comes first, and
+    // returns the best feasible solution found so far
+    template<class Rep, class Period>
+    void setTimeBudget(std::chrono::duration<Rep, Period> budget) noexcept
+    {
+        timeBudget_ = TimeBudget{budget, timeBudgetCheckPeriod_};
+    }
+    
+    const TimeBudget& getTimeBudget() const noexcept
+    {
+        return timeBudget_;
+    }
+    
+    void setBestSolutionCallback(BestSolutionCallback callback)
+    {
+        bestSolutionCallback_ = std::move(callback);
+    }
+    
+    const BestSolutionCallback& getBestSolutionCallback() const noexcept
+    {
+        return bestSolutionCallback_;
+    }
+    
+    // Runs started from the same seed, on the same instance and with the same settings, are identical.
+    // The seed is drawn from std::random_device at construction, and read with getSeed to log a run and replay it.
+    void setSeed(uint64_t seed) noexcept
+    {
+        seed_ = seed;
+    }
+    
+    uint64_t getSeed() const noexcept
+    {
+        return seed_;
+    }
+    
+    // Runs from the same seed on different streams draw independent sequences, see Heuristic::RandomEngine::forStream.
+    // Workers running in parallel from a single seed each take their own stream.
+    void setStream(size_t stream) noexcept
+    {
+        stream_ = stream;
+    }
+    
+    size_t getStream() const noexcept
+    {
+        return stream_;
+    }
+    
+    protected:
+    Heuristic::RandomEngine startRandomEngine() const
+    {
+        return Heuristic::RandomEngine::forStream(seed_, stream_);
+    }
+    
+    // Copy of the time budget, counting from now
+    TimeBudget startTimeBudget() const noexcept
+    {
+        TimeBudget timeBudget = timeBudget_;
+        timeBudget.start();
+        return timeBudget;
+    }
+    
+    static Heuristic::SearchProgress progressOf(size_t performedIterations, size_t iterations, const TimeBudget& timeBudget) noexcept
+    {
+        return {performedIterations,
+                iterations == unlimitedIterations ? 0.0 : static_cast<double>(performedIterations) / iterations,
+                timeBudget.getElapsedFraction()};
+    }
+    
+    private:
+    uint64_t seed_;
+    size_t stream_;
+    size_t timeBudgetCheckPeriod_;
+    TimeBudget timeBudget_;
+    BestSolutionCallback bestSolutionCallback_;
+};
+
+}
+
+#endif // ANYTIME_SOLVER_SETTINGS_HXX
@@ -0,0 +1,89 @@
+#ifndef BEST_SOLUTION_RECORDER_HXX
+#define BEST_SOLUTION_RECORDER_HXX
+
+#include <limits>
+#include <utility>
+
+#include <CompactRoutes.hxx>
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <GenericCVRPSolver.hxx>
+#include <SearchSolution.hxx>
+
+namespace Solver
+{
+
+// Best feasible solution met by a run, kept as a copy of its flat routes, which does not allocate once the first copy
+// has been made. Each new best solution is passed to the callback, if any.
+class BestSolutionRecorder
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    
+    public:
+    // A solution is only recorded if it is shorter than the best one by more than 'threshold'
+    BestSolutionRecorder(const CVRPInstance& instance, BestSolutionCallback callback, double threshold = 0.0)
+    : instance_{&instance},
+      callback_{std::move(callback)},
+      threshold_{threshold},
+      routes_{},
+      distance_{std::numeric_limits<double>::infinity()}
+    {}
+    
+    BestSolutionRecorder(const BestSolutionRecorder&) = default;
+    BestSolutionRecorder(BestSolutionRecorder&&) = default;
+    
+    BestSolutionRecorder& operator=(const BestSolutionRecorder&) = default;
+    BestSolutionRecorder& operator=(BestSolutionRecorder&&) = default;
+    
+    // Keeps a copy of the solution if it is feasible and shorter than the best one, and returns whether it did
+    bool record(const Heuristic::SearchSolution& solution)
+    {
+        if(!solution.isFeasible() || !(solution.getDistance() < distance_ - threshold_))
+        {
+            return false;
+        }
+        
+        routes_ = solution.getRoutes();
+        distance_ = solution.getDistance();
+        
+        if(callback_)
+        {
+            callback_(CVRPSolution{borrowedInstance, *instance_, routes_.toSolutionData(*instance_)});
+        }
+        
+        return true;
+    }
+    
+    bool hasSolution() const noexcept
+    {
+        return distance_ != std::numeric_limits<double>::infinity();
+    }
+    
+    // Infinite until a feasible solution is recorded
+    double getDistance() const noexcept
+    {
+        return distance_;
+    }
+    
+    const CompactRoutes& getRoutes() const noexcept
+    {
+        return routes_;
+    }
+    
+    CVRPSolution toSolution() const
+    {
+        return {*instance_, routes_.toSolutionData(*instance_)};
+    }
+    
+    private:
+    const CVRPInstance* instance_;
+    BestSolutionCallback callback_;
+    double threshold_;
+    CompactRoutes routes_;
+    double distance_;
+};
+
+}
+
+#endif // BEST_SOLUTION_RECORDER_HXX
@@ -0,0 +1,56 @@
+#ifndef BOUNDING_BOX_HXX
+#define BOUNDING_BOX_HXX
+
+#include <algorithm>
+#include <limits>
+
+#include <Coordinates.hxx>
+
+namespace Heuristic
+{
+
+// Axis-aligned box covering a set of customers
+class BoundingBox
+{
+    public:
+    BoundingBox() noexcept
+    : min_{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()},
+      max_{-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()}
+    {}
+    
+    BoundingBox(const BoundingBox&) = default;
+    BoundingBox(BoundingBox&&) = default;
+    
+    BoundingBox& operator=(const BoundingBox&) = default;
+    BoundingBox& operator=(BoundingBox&&) = default;
+    
+    bool isEmpty() const noexcept { return min_.x > max_.x; }
+    Coordinates getMin() const noexcept { return min_; }
+    Coordinates getMax() const noexcept { return max_; }
+    
+    void extend(Coordinates point) noexcept
+    {
+        min_.x = std::min(min_.x, point.x);
+        min_.y = std::min(min_.y, point.y);
+        max_.x = std::max(max_.x, point.x);
+        max_.y = std::max(max_.y, point.y);
+    }
+    
+    void clear() noexcept
+    {
+        *this = BoundingBox{};
+    }
+    
+    bool overlaps(const BoundingBox& other) const noexcept
+    {
+        return min_.x <= other.max_.x && other.min_.x <= max_.x && min_.y <= other.max_.y && other.min_.y <= max_.y;
+    }
+    
+    private:
+    Coordinates min_;
+    Coordinates max_;
+};
+
+}
+
+#endif // BOUNDING_BOX_HXX
@@ -2,6 +2,7 @@
 #define CVRPINSTANCE_HXX
 
 #include <functional>
+#include <vector>
 
 #include <lemon/maps.h>
 #include <lemon/full_graph.h>
@@ -161,6 +162,29 @@ class CVRPInstance
         return costMap_;
     }
     
+    // Same costs as the cost map, but stored as a flat row-major matrix indexed by node ids (zero on the diagonal),
+    // which is what the evaluation kernels work on
+    const std::vector<CostType>& getCostMatrix() const noexcept
+    {
+        return costMatrix_;
+    }
+    
+    CostType getCostOfIds(size_t id1, size_t id2) const noexcept
+    {
+        return costMatrix_[id1 * graph_.nodeNum() + id2];
+    }
+    
+    // Demands indexed by node ids
+    const std::vector<DemandType>& getDemands() const noexcept
+    {
+        return demands_;
+    }
+    
+    DemandType getDemandOfId(size_t id) const noexcept
+    {
+        return demands_[id];
+    }
+    
     GraphType::NodeIt getNodeIt() const noexcept
     {
         return GraphType::NodeIt{graph_};
@@ -216,17 +240,28 @@ class CVRPInstance
     {
         lemon::mapCopy(graph_, coordinatesMap, coordinatesMap_);
         lemon::mapCopy(graph_, demandMap, demandMap_);
+        
+        demands_.assign(graph_.nodeNum(), 0);
+        for(GraphType::NodeIt n(graph_); n != lemon::INVALID; ++n)
+        {
+            demands_[graph_.id(n)] = demandMap_[n];
+        }
     }
     
     void initializeCostMap(const std::function<CostFunctionType>& costFunction)
     {
+        size_t nodeNum = graph_.nodeNum();
+        costMatrix_.assign(nodeNum * nodeNum, 0.0);
+        
         for(GraphType::NodeIt n1(graph_); n1 != lemon::INVALID; ++n1)
         {
             for(GraphType::NodeIt n2(graph_); n2 != lemon::INVALID; ++n2)
             {
                 if(n1 != n2)
                 {
-                    costMap_.set(graph_.edge(n1, n2), costFunction(coordinatesMap_[n1], coordinatesMap_[n2]));
+                    auto cost = costFunction(coordinatesMap_[n1], coordinatesMap_[n2]);
+                    costMap_.set(graph_.edge(n1, n2), cost);
+                    costMatrix_[graph_.id(n1) * nodeNum + graph_.id(n2)] = cost;
                 }
             }
         }
@@ -240,6 +275,8 @@ class CVRPInstance
     CoordinatesMap coordinatesMap_;
     CostMap costMap_; // Can't be const due to implementation quirks of LEMON, but should not be modified !!
     std::function<CostFunctionType> costFunction_;
+    std::vector<CostType> costMatrix_;
+    std::vector<DemandType> demands_;
 };
 
 }
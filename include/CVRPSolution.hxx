@@ -1,30 +1,55 @@
 #ifndef CVRPSOLUTION_HXX
 #define CVRPSOLUTION_HXX
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <CVRPInstance.hxx>
 
 namespace Solver
 {
-    
+
 class CVRPSolution; 
 
 using CVRPSolutionData = std::vector<std::vector<Data::CVRPInstance::GraphType::Node>>;
-    
-template<size_t wrongCapacityPenalty>
+
 class CVRPSolutionCostProcessor
 {
     public:
+    static constexpr double defaultWrongCapacityPenalty = 1000.0;
+    
+    public:
+    explicit CVRPSolutionCostProcessor(double wrongCapacityPenalty = defaultWrongCapacityPenalty) noexcept
+    : wrongCapacityPenalty_{wrongCapacityPenalty}
+    {}
+    
+    CVRPSolutionCostProcessor(const CVRPSolutionCostProcessor&) = default;
+    CVRPSolutionCostProcessor(CVRPSolutionCostProcessor&&) = default;
+    
+    CVRPSolutionCostProcessor& operator=(const CVRPSolutionCostProcessor&) = default;
+    CVRPSolutionCostProcessor& operator=(CVRPSolutionCostProcessor&&) = default;
+    
+    double getWrongCapacityPenalty() const noexcept { return wrongCapacityPenalty_; }
+    void setWrongCapacityPenalty(double wrongCapacityPenalty) noexcept { wrongCapacityPenalty_ = wrongCapacityPenalty; }
     
     double computeCost(const Data::CVRPInstance& instance, const CVRPSolutionData& data) const noexcept
+    {
+        return computeCost(computeDistance(instance, data), computeExcessLoad(instance, data));
+    }
+    
+    // Cost of a solution whose distance and excess load are already known, typically kept up to date by the caller
+    double computeCost(double distance, size_t excessLoad) const noexcept
+    {
+        return distance + excessLoad * wrongCapacityPenalty_;
+    }
+    
+    double computeDistance(const Data::CVRPInstance& instance, const CVRPSolutionData& data) const noexcept
     {
         double totalCost = 0.0;
-       
+        
         for(const auto& route : data) 
         {
-            size_t currentDemand = 0; 
-           
             auto current = route.begin();
             auto next = current + 1; 
             
@@ -33,36 +58,41 @@ class CVRPSolutionCostProcessor
                 continue;
             }
             
-            totalCost += instance.getCostOf(instance.getDepotNode(), *current);
+            totalCost += instance.getCostOfIds(instance.idOfDepot(), instance.idOf(*current));
             
             for(; next != route.end(); ++current, ++next)
             {
-                totalCost += instance.getCostOf(*current, *next);
-                currentDemand += instance.getDemandOf(*current);
+                totalCost += instance.getCostOfIds(instance.idOf(*current), instance.idOf(*next));
             }
             
-            currentDemand += instance.getDemandOf(*current);
-            
-            totalCost += instance.getCostOf(*current, instance.getDepotNode());
+            totalCost += instance.getCostOfIds(instance.idOf(*current), instance.idOfDepot());
+        }
+        
+        return totalCost;
+    }
+    
+    size_t computeExcessLoad(const Data::CVRPInstance& instance, const CVRPSolutionData& data) const noexcept
+    {
+        size_t excessLoad = 0;
+        
+        for(const auto& route : data)
+        {
+            size_t currentDemand = 0;
             
-            if(currentDemand > instance.getVehicleCapacity())
+            for(const auto& node : route)
             {
-                totalCost += (currentDemand - instance.getVehicleCapacity()) * wrongCapacityPenalty;
-            }   
+                currentDemand += instance.getDemandOf(node);
+            }
             
-            /* std::cout << currentDemand << std::endl;
-            size_t actual = 0;
-            for(auto node : route)
+            if(currentDemand > instance.getVehicleCapacity())
             {
-                std::cout << instance.idOf(node) << " ";
-                actual += instance.getDemandOf(node);
+                excessLoad += currentDemand - instance.getVehicleCapacity();
             }
-            std::cout << std::endl << actual << std::endl; */
         }
         
-        return totalCost;
+        return excessLoad;
     }
- 
+    
     bool satisfiesConstraints(const Data::CVRPInstance& instance, const CVRPSolutionData& data) const noexcept
     {
         if(data.size() > instance.getNumberOfVehicles())
@@ -86,8 +116,129 @@ class CVRPSolutionCostProcessor
         
         return true;
     }
+    
+    private:
+    double wrongCapacityPenalty_;
+};
+
+// Keeps the load of every route and the total excess load of a solution up to date
+// as customers are moved around, so that the penalty term never has to be recomputed from scratch.
+class CVRPRouteLoads
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    using Node = CVRPInstance::Node;
+    using DemandType = CVRPInstance::DemandType;
+    
+    public:
+    CVRPRouteLoads(const CVRPInstance& instance, const CVRPSolutionData& data)
+    : instance_{&instance},
+      loads_(data.size(), 0),
+      excessLoad_{0}
+    {
+        for(size_t idx = 0; idx < data.size(); ++idx)
+        {
+            for(const auto& node : data[idx])
+            {
+                loads_[idx] += instance.getDemandOf(node);
+            }
+            
+            excessLoad_ += getExcessOf(idx);
+        }
+    }
+    
+    CVRPRouteLoads(const CVRPRouteLoads&) = default;
+    CVRPRouteLoads(CVRPRouteLoads&&) = default;
+    
+    CVRPRouteLoads& operator=(const CVRPRouteLoads&) = default;
+    CVRPRouteLoads& operator=(CVRPRouteLoads&&) = default;
+    
+    size_t getNumberOfRoutes() const noexcept { return loads_.size(); }
+    size_t getExcessLoad() const noexcept { return excessLoad_; }
+    bool isFeasible() const noexcept { return excessLoad_ == 0; }
+    
+    size_t getLoadOf(size_t route) const noexcept
+    {
+        return loads_[route];
+    }
+    
+    size_t getExcessOf(size_t route) const noexcept
+    {
+        return getExcessOfLoad(loads_[route]);
+    }
+    
+    // Excess of a route carrying the given load
+    size_t getExcessOfLoad(size_t load) const noexcept
+    {
+        auto capacity = instance_->getVehicleCapacity();
+        return load > capacity ? load - capacity : 0;
+    }
+    
+    // Total excess load if the loads of the two given (distinct) routes were replaced by the given ones
+    size_t getExcessLoadAfterChange(size_t route1, size_t newLoad1, size_t route2, size_t newLoad2) const noexcept
+    {
+        auto capacity = instance_->getVehicleCapacity();
+        return excessLoad_ - getExcessOf(route1) - getExcessOf(route2)
+             + (newLoad1 > capacity ? newLoad1 - capacity : 0)
+             + (newLoad2 > capacity ? newLoad2 - capacity : 0);
+    }
+    
+    size_t getExcessLoadAfterMove(size_t fromRoute, size_t toRoute, DemandType demand) const noexcept
+    {
+        if(fromRoute == toRoute)
+        {
+            return excessLoad_;
+        }
+        
+        return getExcessLoadAfterChange(fromRoute, loads_[fromRoute] - demand, toRoute, loads_[toRoute] + demand);
+    }
+    
+    void addDemand(size_t route, DemandType demand) noexcept
+    {
+        excessLoad_ -= getExcessOf(route);
+        loads_[route] += demand;
+        excessLoad_ += getExcessOf(route);
+    }
+    
+    void removeDemand(size_t route, DemandType demand) noexcept
+    {
+        excessLoad_ -= getExcessOf(route);
+        loads_[route] -= demand;
+        excessLoad_ += getExcessOf(route);
+    }
+    
+    void moveNode(size_t fromRoute, size_t toRoute, const Node& node) noexcept
+    {
+        auto demand = instance_->getDemandOf(node);
+        removeDemand(fromRoute, demand);
+        addDemand(toRoute, demand);
+    }
+    
+    void moveCustomer(size_t fromRoute, size_t toRoute, size_t customerId) noexcept
+    {
+        auto demand = instance_->getDemandOfId(customerId);
+        removeDemand(fromRoute, demand);
+        addDemand(toRoute, demand);
+    }
+    
+    private:
+    const CVRPInstance* instance_;
+    std::vector<size_t> loads_;
+    size_t excessLoad_;
+};
+
+// Tag of the CVRPSolution constructor which refers to the instance without owning it
+struct BorrowedInstance
+{
+    explicit BorrowedInstance() = default;
 };
 
+inline constexpr BorrowedInstance borrowedInstance{};
+
+// A solution holds a shared handle to its instance, so it is cheap to copy, move, swap and assign, and can be stored
+// in containers (populations, pools ...).
+// Built from a reference, the solution owns a copy of the instance. Built from a shared pointer, it shares the
+// ownership of the instance. Built with the 'borrowedInstance' tag, it only refers to the instance and copies nothing.
 class CVRPSolution
 {
     private:
@@ -96,21 +247,48 @@ class CVRPSolution
     
     public:
     using DataType = CVRPSolutionData; 
+    using InstanceHandle = std::shared_ptr<const CVRPInstance>;
     
     public:
-    CVRPSolution(const CVRPInstance& instance, const DataType& data)
-    : instance_{instance},
-      data_{data}
+    // Copies the instance, which may then be destroyed before the solution
+    CVRPSolution(const CVRPInstance& instance, DataType data)
+    : instance_{std::make_shared<const CVRPInstance>(instance)},
+      data_{std::move(data)}
     {}
     
+    CVRPSolution(InstanceHandle instance, DataType data) noexcept
+    : instance_{std::move(instance)},
+      data_{std::move(data)}
+    {}
+    
+    // Refers to the instance without copying it : the instance must outlive the solution and all its copies
+    CVRPSolution(BorrowedInstance, const CVRPInstance& instance, DataType data) noexcept
+    : instance_{InstanceHandle{}, &instance},
+      data_{std::move(data)}
+    {}
+    
+    // A temporary instance would not outlive the solution
+    CVRPSolution(BorrowedInstance, const CVRPInstance&& instance, DataType data) = delete;
+    
     CVRPSolution(const CVRPSolution&) = default;
     CVRPSolution(CVRPSolution&&) = default;
     
-    CVRPSolution& operator=(const CVRPSolution&) = delete;
-    CVRPSolution& operator=(CVRPSolution&&) = delete;
+    CVRPSolution& operator=(const CVRPSolution&) = default;
+    CVRPSolution& operator=(CVRPSolution&&) = default;
+    
+    void swap(CVRPSolution& other) noexcept
+    {
+        using std::swap;
+        swap(instance_, other.instance_);
+        swap(data_, other.data_);
+        swap(costProcessor_, other.costProcessor_);
+    }
     
-    const CVRPInstance& getOriginalInstance() const noexcept { return instance_; }
-    const DataType& getData() const noexcept { return data_; }
+    const CVRPInstance& getOriginalInstance() const noexcept { return *instance_; }
+    const InstanceHandle& getInstanceHandle() const noexcept { return instance_; }
+    const DataType& getData() const & noexcept { return data_; }
+    DataType&& getData() && noexcept { return std::move(data_); }
+    void setData(DataType data) noexcept { data_ = std::move(data); }
     size_t getNumberOfRoutes() const noexcept { return data_.size(); }
     
     const std::vector<GraphType::Node>& getRoute(size_t idx) const
@@ -125,7 +303,7 @@ class CVRPSolution
     
     double computeCost() const noexcept
     {
-        return costProcessor_.computeCost(instance_, data_);
+        return costProcessor_.computeCost(*instance_, data_);
     } 
     
     auto begin() const noexcept { return data_.begin(); }
@@ -139,18 +317,21 @@ class CVRPSolution
     auto crend() const noexcept { return data_.crend(); }
     
     protected:
-    const CVRPInstance instance_;
+    InstanceHandle instance_;
     DataType data_;
     
-    static constexpr size_t wrongCapacityPenalty_ = 1000;
-    
     public:
-    using CostProcessor = CVRPSolutionCostProcessor<wrongCapacityPenalty_>;
+    using CostProcessor = CVRPSolutionCostProcessor;
     
     private:
-    CVRPSolutionCostProcessor<wrongCapacityPenalty_> costProcessor_;
+    CostProcessor costProcessor_;
 };
 
+inline void swap(CVRPSolution& lhs, CVRPSolution& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
 }
 
 #endif // CVRPSOLUTION_HXX
\ No newline at end of file
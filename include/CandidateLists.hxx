@@ -0,0 +1,79 @@
+#ifndef CANDIDATE_LISTS_HXX
+#define CANDIDATE_LISTS_HXX
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <CVRPInstance.hxx>
+
+namespace Heuristic
+{
+
+// The k nearest customers of every customer, by increasing cost, stored in a flat array indexed by node ids.
+// Granular neighbourhoods only generate moves creating an edge between a customer and one of its candidates,
+// as moves linking far away customers almost never improve a solution.
+class CandidateLists
+{
+    public:
+    using IdType = uint32_t;
+    
+    public:
+    CandidateLists(const Data::CVRPInstance& instance, size_t size)
+    : size_{std::min(size, instance.getNumberOfNodes() > 2 ? instance.getNumberOfNodes() - 2 : size_t{0})},
+      candidates_(instance.getNumberOfNodes() * size_)
+    {
+        if(size_ == 0)
+        {
+            return;
+        }
+        
+        size_t numberOfNodes = instance.getNumberOfNodes();
+        size_t depot = instance.idOfDepot();
+        std::vector<IdType> others;
+        others.reserve(numberOfNodes);
+        
+        for(size_t id = 0; id < numberOfNodes; ++id)
+        {
+            if(id == depot)
+            {
+                continue;
+            }
+            
+            others.clear();
+            for(size_t other = 0; other < numberOfNodes; ++other)
+            {
+                if(other != id && other != depot)
+                {
+                    others.push_back(static_cast<IdType>(other));
+                }
+            }
+            
+            std::partial_sort(others.begin(), others.begin() + size_, others.end(), [&](IdType lhs, IdType rhs)
+            {
+                return instance.getCostOfIds(id, lhs) < instance.getCostOfIds(id, rhs);
+            });
+            std::copy(others.begin(), others.begin() + size_, candidates_.begin() + id * size_);
+        }
+    }
+    
+    CandidateLists(const CandidateLists&) = default;
+    CandidateLists(CandidateLists&&) = default;
+    
+    CandidateLists& operator=(const CandidateLists&) = default;
+    CandidateLists& operator=(CandidateLists&&) = default;
+    
+    size_t getSize() const noexcept { return size_; }
+    
+    const IdType* candidatesBegin(size_t id) const noexcept { return candidates_.data() + id * size_; }
+    const IdType* candidatesEnd(size_t id) const noexcept { return candidates_.data() + (id + 1) * size_; }
+    IdType getCandidate(size_t id, size_t rank) const noexcept { return candidates_[id * size_ + rank]; }
+    
+    private:
+    size_t size_;
+    std::vector<IdType> candidates_;
+};
+
+}
+
+#endif // CANDIDATE_LISTS_HXX
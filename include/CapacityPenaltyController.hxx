@@ -0,0 +1,108 @@
+#ifndef CAPACITY_PENALTY_CONTROLLER_HXX
+#define CAPACITY_PENALTY_CONTROLLER_HXX
+
+#include <algorithm>
+
+#include <CVRPSolution.hxx>
+
+namespace Solver
+{
+
+// Drives the capacity penalty of a cost processor toward a target fraction of feasible moves.
+// Every 'window' recorded moves, the penalty is multiplied by 'adjustmentFactor' if too few of them
+// were feasible, and divided by it if too many were, always staying in [minPenalty, maxPenalty].
+// A controller built from a single penalty never adapts, and simply keeps this penalty.
+class CapacityPenaltyController
+{
+    public:
+    explicit CapacityPenaltyController(double penalty = CVRPSolutionCostProcessor::defaultWrongCapacityPenalty) noexcept
+    : penalty_{penalty},
+      targetFeasibleRatio_{0.0},
+      adjustmentFactor_{1.0},
+      window_{0},
+      minPenalty_{penalty},
+      maxPenalty_{penalty},
+      recordedMoves_{0},
+      feasibleMoves_{0}
+    {}
+    
+    CapacityPenaltyController(double initialPenalty,
+                              double targetFeasibleRatio,
+                              double adjustmentFactor = 1.2,
+                              size_t window = 100,
+                              double minPenalty = 1.0,
+                              double maxPenalty = 1000000.0) noexcept
+    : penalty_{std::min(std::max(initialPenalty, minPenalty), maxPenalty)},
+      targetFeasibleRatio_{targetFeasibleRatio},
+      adjustmentFactor_{adjustmentFactor},
+      window_{window},
+      minPenalty_{minPenalty},
+      maxPenalty_{maxPenalty},
+      recordedMoves_{0},
+      feasibleMoves_{0}
+    {}
+    
+    CapacityPenaltyController(const CapacityPenaltyController&) = default;
+    CapacityPenaltyController(CapacityPenaltyController&&) = default;
+    
+    CapacityPenaltyController& operator=(const CapacityPenaltyController&) = default;
+    CapacityPenaltyController& operator=(CapacityPenaltyController&&) = default;
+    
+    double getPenalty() const noexcept { return penalty_; }
+    double getTargetFeasibleRatio() const noexcept { return targetFeasibleRatio_; }
+    bool isAdaptive() const noexcept { return window_ != 0; }
+    
+    // Returns true if the penalty changed, so that the caller can propagate it
+    bool recordMove(bool feasible) noexcept
+    {
+        if(!isAdaptive())
+        {
+            return false;
+        }
+        
+        ++recordedMoves_;
+        feasibleMoves_ += feasible;
+        
+        if(recordedMoves_ < window_)
+        {
+            return false;
+        }
+        
+        double feasibleRatio = static_cast<double>(feasibleMoves_) / recordedMoves_;
+        double oldPenalty = penalty_;
+        
+        recordedMoves_ = 0;
+        feasibleMoves_ = 0;
+        
+        if(feasibleRatio < targetFeasibleRatio_)
+        {
+            penalty_ = std::min(penalty_ * adjustmentFactor_, maxPenalty_);
+        }
+        else if(feasibleRatio > targetFeasibleRatio_)
+        {
+            penalty_ = std::max(penalty_ / adjustmentFactor_, minPenalty_);
+        }
+        
+        return penalty_ != oldPenalty;
+    }
+    
+    void applyTo(CVRPSolutionCostProcessor& costProcessor) const noexcept
+    {
+        costProcessor.setWrongCapacityPenalty(penalty_);
+    }
+    
+    private:
+    double penalty_;
+    double targetFeasibleRatio_;
+    double adjustmentFactor_;
+    size_t window_;
+    double minPenalty_;
+    double maxPenalty_;
+    
+    size_t recordedMoves_;
+    size_t feasibleMoves_;
+};
+
+}
+
+#endif // CAPACITY_PENALTY_CONTROLLER_HXX
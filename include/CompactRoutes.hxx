@@ -0,0 +1,292 @@
+#ifndef COMPACT_ROUTES_HXX
+#define COMPACT_ROUTES_HXX
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <RouteArena.hxx>
+
+namespace Solver
+{
+
+// Packs all the routes of a solution in a single buffer drawn from the per-thread RouteArena.
+// The buffer starts with the offsets of the routes (numberOfRoutes + 1 entries, the last one being the number
+// of customers), followed by the customer ids of every route, one after another, depot excluded.
+// Copying into an already allocated container of sufficient capacity never allocates,
+// and the moves below are done in place, so a candidate neighbour costs no heap allocation at all.
+// Destroy and repair heuristics take customers out of the routes for a while : these unassigned customers are kept
+// after those of the last route, outside of every route but still counted in the number of customers.
+class CompactRoutes
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    
+    public:
+    using IdType = uint32_t;
+    
+    public:
+    CompactRoutes() noexcept
+    : buffer_{nullptr},
+      capacity_{0},
+      numberOfRoutes_{0},
+      numberOfCustomers_{0}
+    {}
+    
+    CompactRoutes(const CVRPInstance& instance, const CVRPSolutionData& data)
+    : CompactRoutes()
+    {
+        size_t numberOfCustomers = 0;
+        
+        for(const auto& route : data)
+        {
+            numberOfCustomers += route.size();
+        }
+        
+        reserve(data.size(), numberOfCustomers);
+        numberOfRoutes_ = data.size();
+        numberOfCustomers_ = numberOfCustomers;
+        
+        IdType* currentOffset = offsets();
+        IdType* currentCustomer = customers();
+        IdType position = 0;
+        
+        for(const auto& route : data)
+        {
+            *currentOffset++ = position;
+            
+            for(const auto& node : route)
+            {
+                *currentCustomer++ = instance.idOf(node);
+            }
+            
+            position += route.size();
+        }
+        
+        *currentOffset = position;
+    }
+    
+    CompactRoutes(const CompactRoutes& other)
+    : CompactRoutes()
+    {
+        *this = other;
+    }
+    
+    CompactRoutes(CompactRoutes&& other) noexcept
+    : CompactRoutes()
+    {
+        swap(other);
+    }
+    
+    ~CompactRoutes()
+    {
+        RouteArena::local().deallocate(buffer_, capacity_);
+    }
+    
+    CompactRoutes& operator=(const CompactRoutes& other)
+    {
+        if(this != &other)
+        {
+            reserve(other.numberOfRoutes_, other.numberOfCustomers_);
+            numberOfRoutes_ = other.numberOfRoutes_;
+            numberOfCustomers_ = other.numberOfCustomers_;
+            std::memcpy(buffer_, other.buffer_, other.usedSize() * sizeof(IdType));
+        }
+        
+        return *this;
+    }
+    
+    CompactRoutes& operator=(CompactRoutes&& other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+    
+    void swap(CompactRoutes& other) noexcept
+    {
+        std::swap(buffer_, other.buffer_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(numberOfRoutes_, other.numberOfRoutes_);
+        std::swap(numberOfCustomers_, other.numberOfCustomers_);
+    }
+    
+    CVRPSolutionData toSolutionData(const CVRPInstance& instance) const
+    {
+        CVRPSolutionData data(numberOfRoutes_);
+        
+        for(size_t route = 0; route < numberOfRoutes_; ++route)
+        {
+            data[route].reserve(getRouteSize(route));
+            
+            for(auto it = routeBegin(route); it != routeEnd(route); ++it)
+            {
+                data[route].push_back(instance.getNode(*it));
+            }
+        }
+        
+        return data;
+    }
+    
+    size_t getNumberOfRoutes() const noexcept { return numberOfRoutes_; }
+    size_t getNumberOfCustomers() const noexcept { return numberOfCustomers_; }
+    size_t getRouteSize(size_t route) const noexcept { return offsets()[route + 1] - offsets()[route]; }
+    size_t getRouteOffset(size_t route) const noexcept { return offsets()[route]; }
+    
+    IdType getCustomer(size_t route, size_t position) const noexcept { return customers()[offsets()[route] + position]; }
+    
+    const IdType* routeBegin(size_t route) const noexcept { return customers() + offsets()[route]; }
+    const IdType* routeEnd(size_t route) const noexcept { return customers() + offsets()[route + 1]; }
+    IdType* routeBegin(size_t route) noexcept { return customers() + offsets()[route]; }
+    IdType* routeEnd(size_t route) noexcept { return customers() + offsets()[route + 1]; }
+    
+    size_t getNumberOfUnassigned() const noexcept { return numberOfCustomers_ - offsets()[numberOfRoutes_]; }
+    const IdType* unassignedBegin() const noexcept { return customers() + offsets()[numberOfRoutes_]; }
+    const IdType* unassignedEnd() const noexcept { return customers() + numberOfCustomers_; }
+    
+    // Flat views over the whole storage, mainly for evaluation kernels
+    const IdType* offsets() const noexcept { return buffer_; }
+    const IdType* customers() const noexcept { return buffer_ + numberOfRoutes_ + 1; }
+    IdType* offsets() noexcept { return buffer_; }
+    IdType* customers() noexcept { return buffer_ + numberOfRoutes_ + 1; }
+    
+    // Moves the customer at 'fromPosition' in 'fromRoute' so that it ends at 'toPosition' in 'toRoute'.
+    // 'toPosition' is expressed in the destination route once the customer has been removed, so it ranges
+    // from 0 to the size of the destination route (minus one if both routes are the same).
+    void relocate(size_t fromRoute, size_t fromPosition, size_t toRoute, size_t toPosition) noexcept
+    {
+        moveSegment(fromRoute, fromPosition, fromPosition + 1, toRoute, toPosition);
+    }
+    
+    // Moves the segment [begin, end) of 'fromRoute' so that it starts at 'toPosition' in 'toRoute', with the
+    // same conventions as relocate : 'toPosition' is expressed in the destination route once the segment has been removed
+    void moveSegment(size_t fromRoute, size_t begin, size_t end, size_t toRoute, size_t toPosition) noexcept
+    {
+        IdType* offs = offsets();
+        IdType* custs = customers();
+        
+        size_t length = end - begin;
+        size_t source = offs[fromRoute] + begin;
+        size_t destination = offs[toRoute] + toPosition - (toRoute > fromRoute ? length : 0);
+        
+        if(destination < source)
+        {
+            std::rotate(custs + destination, custs + source, custs + source + length);
+        }
+        else if(destination > source)
+        {
+            std::rotate(custs + source, custs + source + length, custs + destination + length);
+        }
+        
+        for(size_t route = fromRoute + 1; route <= toRoute; ++route)
+        {
+            offs[route] -= length;
+        }
+        
+        for(size_t route = toRoute + 1; route <= fromRoute; ++route)
+        {
+            offs[route] += length;
+        }
+    }
+    
+    // Takes the customer out of its route, it becomes the first unassigned customer
+    void unassign(size_t route, size_t position) noexcept
+    {
+        IdType* offs = offsets();
+        IdType* custs = customers();
+        size_t source = offs[route] + position;
+        
+        std::rotate(custs + source, custs + source + 1, custs + offs[numberOfRoutes_]);
+        
+        for(size_t next = route + 1; next <= numberOfRoutes_; ++next)
+        {
+            --offs[next];
+        }
+    }
+    
+    // Inserts the 'index'-th unassigned customer at 'position' in the route
+    void assign(size_t index, size_t route, size_t position) noexcept
+    {
+        IdType* offs = offsets();
+        IdType* custs = customers();
+        size_t source = offs[numberOfRoutes_] + index;
+        size_t destination = offs[route] + position;
+        
+        std::rotate(custs + destination, custs + source, custs + source + 1);
+        
+        for(size_t next = route + 1; next <= numberOfRoutes_; ++next)
+        {
+            ++offs[next];
+        }
+    }
+    
+    // Reverses the order of the segment [begin, end) of the route
+    void reverse(size_t route, size_t begin, size_t end) noexcept
+    {
+        std::reverse(routeBegin(route) + begin, routeBegin(route) + end);
+    }
+    
+    // Exchanges the segment [begin1, end1) of 'route1' with the segment [begin2, end2) of 'route2', where the routes
+    // are distinct, and the segments may have different lengths (or be empty). The segments keep their orientation.
+    void swapSegments(size_t route1, size_t begin1, size_t end1, size_t route2, size_t begin2, size_t end2) noexcept
+    {
+        if(route1 > route2)
+        {
+            std::swap(route1, route2);
+            std::swap(begin1, begin2);
+            std::swap(end1, end2);
+        }
+        
+        IdType* offs = offsets();
+        IdType* custs = customers();
+        
+        // Layout is X M Y, with X and Y the segments, and we want Y M X
+        IdType* first = custs + offs[route1] + begin1;
+        IdType* middle = custs + offs[route1] + end1;
+        IdType* second = custs + offs[route2] + begin2;
+        IdType* last = custs + offs[route2] + end2;
+        
+        std::rotate(first, second, last);
+        std::rotate(first + (last - second), first + (last - second) + (middle - first), last);
+        
+        IdType length1 = end1 - begin1;
+        IdType length2 = end2 - begin2;
+        
+        for(size_t route = route1 + 1; route <= route2; ++route)
+        {
+            offs[route] = offs[route] + length2 - length1;
+        }
+    }
+    
+    private:
+    size_t usedSize() const noexcept { return buffer_ == nullptr ? 0 : numberOfRoutes_ + 1 + numberOfCustomers_; }
+    
+    // Content is not preserved
+    void reserve(size_t numberOfRoutes, size_t numberOfCustomers)
+    {
+        size_t required = numberOfRoutes + 1 + numberOfCustomers;
+        
+        if(required > capacity_)
+        {
+            auto& arena = RouteArena::local();
+            arena.deallocate(buffer_, capacity_);
+            buffer_ = arena.allocate(required, capacity_);
+        }
+    }
+    
+    IdType* buffer_;
+    size_t capacity_;
+    size_t numberOfRoutes_;
+    size_t numberOfCustomers_;
+};
+
+inline void swap(CompactRoutes& lhs, CompactRoutes& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+}
+
+#endif // COMPACT_ROUTES_HXX
@@ -0,0 +1,148 @@
+#ifndef COST_EVALUATION_KERNEL_HXX
+#define COST_EVALUATION_KERNEL_HXX
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <CompactRoutes.hxx>
+#include <CVRPInstance.hxx>
+
+namespace Solver
+{
+
+// Full (non incremental) evaluation of compact solutions, straight from the flat cost matrix of the instance.
+// Within a route, consecutive customers are read by blocks of four, and the matching matrix entries
+// are fetched with a single gather and accumulated in a vector register when AVX2 is available
+// (scalar code with independent accumulators otherwise).
+class CostEvaluationKernel
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    using IdType = CompactRoutes::IdType;
+    
+    public:
+    static double computeDistance(const CVRPInstance& instance, const CompactRoutes& routes) noexcept
+    {
+        return computeDistance(instance.getCostMatrix().data(), instance.getNumberOfNodes(), instance.idOfDepot(), routes);
+    }
+    
+    static size_t computeExcessLoad(const CVRPInstance& instance, const CompactRoutes& routes) noexcept
+    {
+        return computeExcessLoad(instance.getDemands().data(), instance.getVehicleCapacity(), routes);
+    }
+    
+    // Evaluates a whole batch (a population for instance) in a single call. The instance data is looked up once,
+    // and the solutions are streamed one after another so that the hot part of the matrix stays in cache.
+    // 'distances' and 'excessLoads' must be able to hold one value per solution of [first, last).
+    template<class Iterator>
+    static void computeBatch(const CVRPInstance& instance, Iterator first, Iterator last, double* distances, size_t* excessLoads) noexcept
+    {
+        const double* costMatrix = instance.getCostMatrix().data();
+        const size_t* demands = instance.getDemands().data();
+        size_t numberOfNodes = instance.getNumberOfNodes();
+        size_t capacity = instance.getVehicleCapacity();
+        size_t depot = instance.idOfDepot();
+        
+        for(; first != last; ++first)
+        {
+            const CompactRoutes& routes = *first;
+            *distances++ = computeDistance(costMatrix, numberOfNodes, depot, routes);
+            
+            if(excessLoads != nullptr)
+            {
+                *excessLoads++ = computeExcessLoad(demands, capacity, routes);
+            }
+        }
+    }
+    
+    static double computeDistance(const double* costMatrix, size_t numberOfNodes, size_t depot, const CompactRoutes& routes) noexcept
+    {
+        double totalCost = 0.0;
+        
+        for(size_t route = 0; route < routes.getNumberOfRoutes(); ++route)
+        {
+            const IdType* first = routes.routeBegin(route);
+            const IdType* last = routes.routeEnd(route);
+            
+            if(first == last)
+            {
+                continue;
+            }
+            
+            totalCost += costMatrix[depot * numberOfNodes + *first];
+            totalCost += computePathDistance(costMatrix, numberOfNodes, first, last);
+            totalCost += costMatrix[*(last - 1) * numberOfNodes + depot];
+        }
+        
+        return totalCost;
+    }
+    
+    static size_t computeExcessLoad(const size_t* demands, size_t capacity, const CompactRoutes& routes) noexcept
+    {
+        size_t excessLoad = 0;
+        
+        for(size_t route = 0; route < routes.getNumberOfRoutes(); ++route)
+        {
+            size_t load = 0;
+            
+            for(const IdType* it = routes.routeBegin(route); it != routes.routeEnd(route); ++it)
+            {
+                load += demands[*it];
+            }
+            
+            excessLoad += load > capacity ? load - capacity : 0;
+        }
+        
+        return excessLoad;
+    }
+    
+    // Sum of the costs of the edges between consecutive customers of [first, last), depot excluded
+    static double computePathDistance(const double* costMatrix, size_t numberOfNodes, const IdType* first, const IdType* last) noexcept
+    {
+        size_t numberOfEdges = last - first - 1;
+        size_t idx = 0;
+        double totalCost = 0.0;
+
+#if defined(__AVX2__)
+        __m256d accumulator = _mm256_setzero_pd();
+        const __m128i stride = _mm_set1_epi32(static_cast<int>(numberOfNodes));
+        
+        for(; idx + 4 <= numberOfEdges; idx += 4)
+        {
+            __m128i from = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + idx));
+            __m128i to = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + idx + 1));
+            __m128i offsets = _mm_add_epi32(_mm_mullo_epi32(from, stride), to);
+            accumulator = _mm256_add_pd(accumulator, _mm256_i32gather_pd(costMatrix, offsets, sizeof(double)));
+        }
+        
+        __m128d halves = _mm_add_pd(_mm256_castpd256_pd128(accumulator), _mm256_extractf128_pd(accumulator, 1));
+        totalCost = _mm_cvtsd_f64(_mm_add_sd(halves, _mm_unpackhi_pd(halves, halves)));
+#else
+        double partialCosts[4] = {0.0, 0.0, 0.0, 0.0};
+        
+        for(; idx + 4 <= numberOfEdges; idx += 4)
+        {
+            partialCosts[0] += costMatrix[first[idx] * numberOfNodes + first[idx + 1]];
+            partialCosts[1] += costMatrix[first[idx + 1] * numberOfNodes + first[idx + 2]];
+            partialCosts[2] += costMatrix[first[idx + 2] * numberOfNodes + first[idx + 3]];
+            partialCosts[3] += costMatrix[first[idx + 3] * numberOfNodes + first[idx + 4]];
+        }
+        
+        totalCost = (partialCosts[0] + partialCosts[1]) + (partialCosts[2] + partialCosts[3]);
+#endif
+
+        for(; idx < numberOfEdges; ++idx)
+        {
+            totalCost += costMatrix[first[idx] * numberOfNodes + first[idx + 1]];
+        }
+        
+        return totalCost;
+    }
+};
+
+}
+
+#endif // COST_EVALUATION_KERNEL_HXX
@@ -0,0 +1,150 @@
+#ifndef CROSS_EXCHANGE_NEIGHBOURHOOD_HXX
+#define CROSS_EXCHANGE_NEIGHBOURHOOD_HXX
+
+#include <algorithm>
+#include <random>
+
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// CROSS-exchange : two segments of at most 'maxSegmentLength' consecutive customers, taken from distinct routes,
+// exchange their places, keeping their orientation. One of the segments may be empty, in which case the move
+// is a segment relocation. Gain and loads are evaluated in constant time from the prefix data of the routes.
+template<size_t maxSegmentLength = 3>
+class CrossExchangeNeighbourhood : public GenericNeighbourhoodGenerator<CrossExchangeNeighbourhood<maxSegmentLength>>
+{
+    private:
+    using Base = GenericNeighbourhoodGenerator<CrossExchangeNeighbourhood<maxSegmentLength>>;
+    
+    public:
+    struct Move
+    {
+        size_t route1;
+        size_t begin1;
+        size_t length1;
+        size_t route2;
+        size_t begin2;
+        size_t length2;
+    };
+    
+    // The segment starting with the customer is exchanged with the one following its candidate, which may be empty.
+    // Variants span the lengths of both segments.
+    static constexpr size_t granularVariants = maxSegmentLength * (maxSegmentLength + 1);
+    
+    static constexpr const char* name = "cross-exchange";
+    
+    public:
+    using Base::Base;
+    
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        if(solution.isGranular())
+        {
+            return Base::randomGranularMove(solution, randomEngine, move);
+        }
+        
+        if(!Base::pickTwoRoutes(solution, randomEngine, move.route1, move.route2) || solution.canSkipRoutePair(move.route1, move.route2))
+        {
+            return false;
+        }
+        
+        pickSegment(solution.getRouteSize(move.route1), randomEngine, move.begin1, move.length1);
+        pickSegment(solution.getRouteSize(move.route2), randomEngine, move.begin2, move.length2);
+        
+        return move.length1 != 0 || move.length2 != 0;
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        return {solution.segmentSwapDelta(move.route1, move.begin1, move.begin1 + move.length1, move.route2, move.begin2, move.begin2 + move.length2),
+                solution.segmentSwapExcessLoad(move.route1, move.begin1, move.begin1 + move.length1, move.route2, move.begin2, move.begin2 + move.length2)};
+    }
+    
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.swapSegments(move.route1, move.begin1, move.begin1 + move.length1, move.route2, move.begin2, move.begin2 + move.length2);
+    }
+    
+    // Each route now holds the other segment at the same starting position
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.swapSegments(move.route1, move.begin1, move.begin1 + move.length2, move.route2, move.begin2, move.begin2 + move.length1);
+    }
+    
+    // Segments starting with the customer, exchanged with every segment of every other route
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor&& visitor) const
+    {
+        if(solution.isGranular())
+        {
+            return Base::forEachGranularMove(solution, customer, visitor);
+        }
+        
+        Move move;
+        move.route1 = solution.routeOf(customer);
+        move.begin1 = solution.positionOf(customer);
+        
+        size_t maxLength1 = std::min(maxSegmentLength, solution.getRouteSize(move.route1) - move.begin1);
+        
+        for(move.route2 = 0; move.route2 < solution.getNumberOfRoutes(); ++move.route2)
+        {
+            if(move.route2 == move.route1 || solution.canSkipRoutePair(move.route1, move.route2))
+            {
+                continue;
+            }
+            
+            size_t size2 = solution.getRouteSize(move.route2);
+            
+            for(move.begin2 = 0; move.begin2 <= size2; ++move.begin2)
+            {
+                size_t maxLength2 = std::min(maxSegmentLength, size2 - move.begin2);
+                
+                for(move.length1 = 1; move.length1 <= maxLength1; ++move.length1)
+                {
+                    for(move.length2 = 0; move.length2 <= maxLength2; ++move.length2)
+                    {
+                        if(visitor(move))
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        
+        return false;
+    }
+    
+    bool granularMove(const SearchSolution& solution, SearchSolution::IdType customer, SearchSolution::IdType candidate, size_t variant, Move& move) const noexcept
+    {
+        move.route1 = solution.routeOf(customer);
+        move.route2 = solution.routeOf(candidate);
+        move.begin1 = solution.positionOf(customer);
+        move.begin2 = solution.positionOf(candidate) + 1;
+        move.length1 = variant / (maxSegmentLength + 1) + 1;
+        move.length2 = variant % (maxSegmentLength + 1);
+        
+        return move.route1 != move.route2
+            && move.begin1 + move.length1 <= solution.getRouteSize(move.route1)
+            && move.begin2 + move.length2 <= solution.getRouteSize(move.route2);
+    }
+    
+    private:
+    template<class RandomEngine>
+    static void pickSegment(size_t routeSize, RandomEngine& randomEngine, size_t& begin, size_t& length)
+    {
+        std::uniform_int_distribution<size_t> lengthPicker(0, std::min(maxSegmentLength, routeSize));
+        length = lengthPicker(randomEngine);
+        
+        std::uniform_int_distribution<size_t> beginPicker(0, routeSize - length);
+        begin = beginPicker(randomEngine);
+    }
+};
+
+}
+
+#endif // CROSS_EXCHANGE_NEIGHBOURHOOD_HXX
@@ -0,0 +1,195 @@
+#ifndef DESTROY_OPERATOR_HXX
+#define DESTROY_OPERATOR_HXX
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+enum class DestroyType
+{
+    Random,  // Removes customers drawn uniformly
+    Worst,   // Removes the customers whose removal saves the most distance
+    Related, // Shaw removal : removes customers related, by their distance and demands, to those already removed
+    Route    // Removes every customer of a random route, whatever their number
+};
+
+// Destroy step of a large neighbourhood search : takes customers out of their routes, in place, leaving them
+// unassigned for a repair operator.
+// The worst and related removals pick their customers one at a time, after ranking every assigned customer, at the
+// rank y^randomness times their number with y uniform in [0, 1) : the larger the randomness, the more often the top
+// ranked customer is picked.
+class DestroyOperator
+{
+    private:
+    using IdType = SearchSolution::IdType;
+    
+    public:
+    static constexpr size_t numberOfTypes = 4;
+    static constexpr double defaultWorstRandomness = 3.0;
+    static constexpr double defaultRelatedRandomness = 6.0;
+    
+    // Weights of the distance and of the demand difference in the relatedness of two customers, both normalised
+    static constexpr double relatedDistanceWeight = 9.0;
+    static constexpr double relatedDemandWeight = 2.0;
+    
+    public:
+    explicit DestroyOperator(double worstRandomness = defaultWorstRandomness, double relatedRandomness = defaultRelatedRandomness)
+    : worstRandomness_{worstRandomness},
+      relatedRandomness_{relatedRandomness},
+      ranking_{}
+    {}
+    
+    DestroyOperator(const DestroyOperator&) = default;
+    DestroyOperator(DestroyOperator&&) = default;
+    
+    DestroyOperator& operator=(const DestroyOperator&) = default;
+    DestroyOperator& operator=(DestroyOperator&&) = default;
+    
+    double getWorstRandomness() const noexcept { return worstRandomness_; }
+    double getRelatedRandomness() const noexcept { return relatedRandomness_; }
+    
+    // Removes 'count' customers, or all of them if there are fewer, except for the route removal
+    template<class RandomEngine>
+    void apply(SearchSolution& solution, DestroyType type, size_t count, RandomEngine& randomEngine)
+    {
+        count = std::min(count, solution.getNumberOfAssigned());
+        
+        if(count == 0)
+        {
+            return;
+        }
+        
+        switch(type)
+        {
+            case DestroyType::Random:
+                removeRandomly(solution, count, randomEngine);
+                break;
+            case DestroyType::Worst:
+                removeWorst(solution, count, randomEngine);
+                break;
+            case DestroyType::Related:
+                removeRelated(solution, count, randomEngine);
+                break;
+            default:
+                removeRoute(solution, randomEngine);
+                break;
+        }
+    }
+    
+    private:
+    // Assigned customers come first in the flat view of the routes
+    template<class RandomEngine>
+    static IdType randomAssignedCustomer(const SearchSolution& solution, RandomEngine& randomEngine)
+    {
+        return solution.getRoutes().customers()[std::uniform_int_distribution<size_t>{0, solution.getNumberOfAssigned() - 1}(randomEngine)];
+    }
+    
+    static void remove(SearchSolution& solution, IdType customer) noexcept
+    {
+        solution.unassign(solution.routeOf(customer), solution.positionOf(customer));
+    }
+    
+    // Customer ranked at y^randomness times the number of ranked customers, 'ranking_' holding (score, customer) pairs
+    template<class RandomEngine>
+    IdType pickRanked(double randomness, RandomEngine& randomEngine)
+    {
+        double y = std::uniform_real_distribution<double>{0.0, 1.0}(randomEngine);
+        size_t rank = std::min(static_cast<size_t>(std::pow(y, randomness) * ranking_.size()), ranking_.size() - 1);
+        
+        std::nth_element(ranking_.begin(), ranking_.begin() + rank, ranking_.end());
+        return ranking_[rank].second;
+    }
+    
+    template<class RandomEngine>
+    void removeRandomly(SearchSolution& solution, size_t count, RandomEngine& randomEngine) const
+    {
+        for(size_t i = 0; i < count; ++i)
+        {
+            remove(solution, randomAssignedCustomer(solution, randomEngine));
+        }
+    }
+    
+    // The savings are computed again after each removal, as removing a customer changes those of its neighbours
+    template<class RandomEngine>
+    void removeWorst(SearchSolution& solution, size_t count, RandomEngine& randomEngine)
+    {
+        for(size_t i = 0; i < count; ++i)
+        {
+            ranking_.clear();
+            
+            for(size_t route = 0; route < solution.getNumberOfRoutes(); ++route)
+            {
+                for(size_t position = 0; position < solution.getRouteSize(route); ++position)
+                {
+                    ranking_.emplace_back(solution.removalDelta(route, position), solution.getCustomer(route, position));
+                }
+            }
+            
+            remove(solution, pickRanked(worstRandomness_, randomEngine));
+        }
+    }
+    
+    // Each customer removed after the seed is related to one of the customers removed before it, drawn uniformly.
+    // Distances are normalised by the largest one from that customer, demands by the vehicle capacity.
+    template<class RandomEngine>
+    void removeRelated(SearchSolution& solution, size_t count, RandomEngine& randomEngine)
+    {
+        double capacity = static_cast<double>(solution.getInstance().getVehicleCapacity());
+        
+        remove(solution, randomAssignedCustomer(solution, randomEngine));
+        
+        for(size_t removed = 1; removed < count; ++removed)
+        {
+            const IdType* unassigned = solution.getRoutes().unassignedBegin();
+            IdType reference = unassigned[std::uniform_int_distribution<size_t>{0, removed - 1}(randomEngine)];
+            const double* costs = solution.costsFrom(reference);
+            double referenceDemand = static_cast<double>(solution.demandOf(reference));
+            double maxCost = 0.0;
+            
+            ranking_.clear();
+            
+            for(const IdType* customer = solution.getRoutes().customers(); customer != unassigned; ++customer)
+            {
+                maxCost = std::max(maxCost, costs[*customer]);
+                ranking_.emplace_back(costs[*customer], *customer);
+            }
+            
+            double distanceScale = maxCost > 0.0 ? relatedDistanceWeight / maxCost : 0.0;
+            double demandScale = capacity > 0.0 ? relatedDemandWeight / capacity : 0.0;
+            
+            for(auto& entry : ranking_)
+            {
+                entry.first = distanceScale * entry.first + demandScale * std::abs(static_cast<double>(solution.demandOf(entry.second)) - referenceDemand);
+            }
+            
+            remove(solution, pickRanked(relatedRandomness_, randomEngine));
+        }
+    }
+    
+    // The route is drawn through one of its customers, so that longer routes are more likely to be removed
+    template<class RandomEngine>
+    static void removeRoute(SearchSolution& solution, RandomEngine& randomEngine)
+    {
+        size_t route = solution.routeOf(randomAssignedCustomer(solution, randomEngine));
+        
+        for(size_t size = solution.getRouteSize(route); size != 0; --size)
+        {
+            solution.unassign(route, size - 1);
+        }
+    }
+    
+    double worstRandomness_;
+    double relatedRandomness_;
+    std::vector<std::pair<double, IdType>> ranking_;
+};
+
+}
+
+#endif // DESTROY_OPERATOR_HXX
@@ -0,0 +1,304 @@
+#ifndef EJECTION_CHAIN_NEIGHBOURHOOD_HXX
+#define EJECTION_CHAIN_NEIGHBOURHOOD_HXX
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <random>
+
+#include <CandidateLists.hxx>
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// Ejection chains : a customer moves to another route and takes the place of one of its customers, which is ejected
+// to a third route, and so on, the last customer being inserted without ejecting anyone. The routes of a chain are all
+// distinct, and a chain moves from 2 to 'maxDepth' customers, single relocations being left to OnePointExtraNeighbourhood.
+// On capacity-tight instances a customer seldom fits in another route as is, while making room for it by pushing one
+// of the customers of that route further often works.
+// In granular mode, and always in 'forEachMove', chains follow candidate edges : each ejected customer is a candidate of
+// the customer taking its place, and the last customer is inserted next to one of its candidates. 'forEachMove' also
+// checks the capacities along the chain, and only follows links leaving the receiving route within its capacity.
+// As the number of chains grows exponentially with their depth, 'forEachMove' builds its own candidate lists of size
+// 'defaultCandidates' when none are attached to the solution.
+template<size_t maxDepth = 3>
+class EjectionChainNeighbourhood : public GenericNeighbourhoodGenerator<EjectionChainNeighbourhood<maxDepth>>
+{
+    static_assert(maxDepth >= 2, "An ejection chain moves at least two customers");
+    
+    private:
+    using Base = GenericNeighbourhoodGenerator<EjectionChainNeighbourhood<maxDepth>>;
+    using IdType = SearchSolution::IdType;
+    
+    public:
+    // The i-th customer of the chain leaves 'routes[i]' from 'positions[i]', and is inserted in 'routes[i + 1]' at
+    // 'insertions[i]', expressed in that route deprived of its own moved customer, apart from the last route
+    struct Move
+    {
+        size_t depth;
+        std::array<size_t, maxDepth + 1> routes;
+        std::array<size_t, maxDepth> positions;
+        std::array<size_t, maxDepth> insertions;
+    };
+    
+    static constexpr size_t defaultCandidates = 10;
+    
+    // Attempts at finding a route outside of the chain when drawing a move, before giving up
+    static constexpr size_t maxDrawAttempts = 16;
+    
+    static constexpr const char* name = "ejection-chain";
+    
+    public:
+    using Base::Base;
+    
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        if(solution.getNumberOfRoutes() < 3 || solution.getNumberOfCustomers() < 2)
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> depthPicker(2, maxDepth);
+        move.depth = std::min(depthPicker(randomEngine), solution.getNumberOfRoutes() - 1);
+        
+        if(solution.isGranular())
+        {
+            return randomGranularChain(solution, randomEngine, move);
+        }
+        
+        std::uniform_int_distribution<size_t> customerPicker(0, solution.getNumberOfCustomers() - 1);
+        std::uniform_int_distribution<size_t> routePicker(0, solution.getNumberOfRoutes() - 1);
+        
+        for(size_t i = 0; i <= move.depth; ++i)
+        {
+            size_t attempts = 0;
+            
+            do
+            {
+                if(attempts++ == maxDrawAttempts)
+                {
+                    return false;
+                }
+                
+                // Every route but the last one must have a customer to move
+                if(i < move.depth)
+                {
+                    IdType customer = solution.getRoutes().customers()[customerPicker(randomEngine)];
+                    move.routes[i] = solution.routeOf(customer);
+                    move.positions[i] = solution.positionOf(customer);
+                }
+                else
+                {
+                    move.routes[i] = routePicker(randomEngine);
+                }
+            } while(isInChain(move, i, move.routes[i]));
+        }
+        
+        for(size_t i = 0; i < move.depth; ++i)
+        {
+            size_t lastInsertion = solution.getRouteSize(move.routes[i + 1]) - (i + 1 < move.depth ? 1 : 0);
+            move.insertions[i] = std::uniform_int_distribution<size_t>(0, lastInsertion)(randomEngine);
+        }
+        
+        return true;
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        const Solver::CVRPRouteLoads& loads = solution.getLoads();
+        
+        IdType customer = solution.getCustomer(move.routes[0], move.positions[0]);
+        double distanceDelta = solution.removalDelta(move.routes[0], move.positions[0]);
+        size_t excessLoad = loads.getExcessLoad() - loads.getExcessOf(move.routes[0])
+                          + loads.getExcessOfLoad(loads.getLoadOf(move.routes[0]) - solution.demandOf(customer));
+        
+        for(size_t i = 1; i < move.depth; ++i)
+        {
+            IdType ejected = solution.getCustomer(move.routes[i], move.positions[i]);
+            
+            distanceDelta += solution.removalDelta(move.routes[i], move.positions[i])
+                           + solution.insertionDelta(move.routes[i], move.positions[i], move.insertions[i - 1], customer);
+            excessLoad += loads.getExcessOfLoad(loads.getLoadOf(move.routes[i]) + solution.demandOf(customer) - solution.demandOf(ejected))
+                        - loads.getExcessOf(move.routes[i]);
+            
+            customer = ejected;
+        }
+        
+        size_t lastRoute = move.routes[move.depth];
+        distanceDelta += solution.insertionDelta(lastRoute, move.insertions[move.depth - 1], customer);
+        excessLoad += loads.getExcessOfLoad(loads.getLoadOf(lastRoute) + solution.demandOf(customer)) - loads.getExcessOf(lastRoute);
+        
+        return {distanceDelta, excessLoad};
+    }
+    
+    // The last customer moves first, so that every other one is inserted in a route already deprived of its own customer
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        for(size_t i = move.depth; i-- > 0;)
+        {
+            solution.relocate(move.routes[i], move.positions[i], move.routes[i + 1], move.insertions[i]);
+        }
+    }
+    
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        for(size_t i = 0; i < move.depth; ++i)
+        {
+            solution.relocate(move.routes[i + 1], move.insertions[i], move.routes[i], move.positions[i]);
+        }
+    }
+    
+    // Chains starting with the customer, built along candidate edges within capacities
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, IdType customer, Visitor&& visitor) const
+    {
+        Move move;
+        move.routes[0] = solution.routeOf(customer);
+        move.positions[0] = solution.positionOf(customer);
+        
+        return extendChain(solution, candidateListsFor(solution), customer, 1, move, visitor);
+    }
+    
+    private:
+    static bool isInChain(const Move& move, size_t length, size_t route) noexcept
+    {
+        for(size_t i = 0; i < length; ++i)
+        {
+            if(move.routes[i] == route)
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    // Moves the customer, the 'level'-th one of the chain, next to each of its candidates lying outside of the chain,
+    // ending the chain there or ejecting the candidate
+    template<class Visitor>
+    bool extendChain(const SearchSolution& solution, const CandidateLists& candidateLists, IdType customer, size_t level, Move& move, Visitor& visitor) const
+    {
+        size_t capacity = solution.getInstance().getVehicleCapacity();
+        size_t demand = solution.demandOf(customer);
+        
+        for(auto candidate = candidateLists.candidatesBegin(customer); candidate != candidateLists.candidatesEnd(customer); ++candidate)
+        {
+            size_t route = solution.routeOf(*candidate);
+            size_t position = solution.positionOf(*candidate);
+            size_t load = solution.getRouteLoad(route);
+            
+            if(isInChain(move, level, route))
+            {
+                continue;
+            }
+            
+            move.routes[level] = route;
+            
+            if(level >= 2 && load + demand <= capacity)
+            {
+                move.depth = level;
+                
+                for(size_t side = 0; side < 2; ++side)
+                {
+                    move.insertions[level - 1] = position + side;
+                    if(visitor(move))
+                    {
+                        return true;
+                    }
+                }
+            }
+            
+            if(level < maxDepth && load + demand - solution.demandOf(*candidate) <= capacity)
+            {
+                move.positions[level] = position;
+                move.insertions[level - 1] = position;
+                
+                if(extendChain(solution, candidateLists, *candidate, level + 1, move, visitor))
+                {
+                    return true;
+                }
+            }
+        }
+        
+        return false;
+    }
+    
+    // Walks along candidate edges from a random customer, each ejected customer being drawn among the candidates of
+    // the previous one which lie outside of the chain
+    template<class RandomEngine>
+    bool randomGranularChain(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        const CandidateLists& candidateLists = *solution.getCandidateLists();
+        std::uniform_int_distribution<size_t> rankPicker(0, candidateLists.getSize() - 1);
+        std::uniform_int_distribution<size_t> sidePicker(0, 1);
+        
+        IdType customer;
+        IdType candidate;
+        Base::pickCandidateEdge(solution, randomEngine, customer, candidate);
+        
+        move.routes[0] = solution.routeOf(customer);
+        move.positions[0] = solution.positionOf(customer);
+        
+        for(size_t level = 1; level <= move.depth; ++level)
+        {
+            // The first candidate was drawn with the customer, the next ones are scanned from a random rank
+            if(level > 1)
+            {
+                size_t firstRank = rankPicker(randomEngine);
+                size_t rank = 0;
+                
+                do
+                {
+                    candidate = candidateLists.getCandidate(customer, (firstRank + rank) % candidateLists.getSize());
+                } while(isInChain(move, level, solution.routeOf(candidate)) && ++rank < candidateLists.getSize());
+            }
+            
+            if(isInChain(move, level, solution.routeOf(candidate)))
+            {
+                return false;
+            }
+            
+            move.routes[level] = solution.routeOf(candidate);
+            
+            if(level == move.depth)
+            {
+                move.insertions[level - 1] = solution.positionOf(candidate) + sidePicker(randomEngine);
+            }
+            else
+            {
+                move.positions[level] = solution.positionOf(candidate);
+                move.insertions[level - 1] = move.positions[level];
+                customer = candidate;
+            }
+        }
+        
+        return true;
+    }
+    
+    const CandidateLists& candidateListsFor(const SearchSolution& solution) const
+    {
+        if(solution.isGranular())
+        {
+            return *solution.getCandidateLists();
+        }
+        
+        if(!ownCandidateLists_ || ownInstance_ != &solution.getInstance())
+        {
+            ownCandidateLists_.emplace(solution.getInstance(), defaultCandidates);
+            ownInstance_ = &solution.getInstance();
+        }
+        
+        return *ownCandidateLists_;
+    }
+    
+    // Candidate lists of the last instance searched without candidate lists, built on first use
+    mutable std::optional<CandidateLists> ownCandidateLists_;
+    mutable const Data::CVRPInstance* ownInstance_ = nullptr;
+};
+
+}
+
+#endif // EJECTION_CHAIN_NEIGHBOURHOOD_HXX
@@ -0,0 +1,69 @@
+#ifndef GENERIC_ACCEPTANCE_POLICY_HXX
+#define GENERIC_ACCEPTANCE_POLICY_HXX
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <Meta.hxx>
+#include <RandomEngine.hxx>
+
+namespace Heuristic
+{
+
+// Progress of a run, as fractions of its number of steps and of its time budget, each one staying at 0 when the
+// run is not bounded that way
+struct SearchProgress
+{
+    size_t steps;
+    double stepFraction;
+    double timeFraction;
+    
+    // Progress toward the bound which ends the run first
+    double getFraction() const noexcept
+    {
+        return std::max(stepFraction, timeFraction);
+    }
+};
+
+// An acceptance policy decides whether a stochastic search moves to the neighbour it drew, costs including penalties :
+// - 'accept(currentCost, newCost, randomEngine)' is called on every evaluated neighbour
+// - 'start(initialCost)' is called at the beginning of a run
+// - 'update(progress)' is called regularly during the run, for the policies following a schedule
+// - 'endStep(currentCost)' is called after every step, whether a neighbour was accepted or not
+// - 'observeDelta(distanceDelta)' is called before 'accept' on the neighbours leaving the excess load unchanged, for
+//   the policies calibrating themselves on the scale of the distances, which the capacity penalty would blur
+// The last four do nothing unless the derived class hides them. The policy being a template parameter of the
+// solver, these calls vanish when they are empty.
+template<class Derived>
+class GenericAcceptancePolicy
+{
+    protected:
+    template<class T, class = void>
+    struct is_accept_implemented_in : std::false_type {};
+    
+    template<class T>
+    struct is_accept_implemented_in<T, Meta::void_t<
+        decltype(std::declval<T&>().accept(std::declval<double>(), std::declval<double>(), std::declval<RandomEngine&>()))>> : std::true_type {};
+    
+    public:
+    GenericAcceptancePolicy()
+    {
+        static_assert(is_accept_implemented_in<Derived>::value, "Invalid derived class : must implement the method 'accept'");
+    }
+    
+    GenericAcceptancePolicy(const GenericAcceptancePolicy&) = default;
+    GenericAcceptancePolicy(GenericAcceptancePolicy&&) = default;
+    
+    GenericAcceptancePolicy& operator=(const GenericAcceptancePolicy&) = default;
+    GenericAcceptancePolicy& operator=(GenericAcceptancePolicy&&) = default;
+    
+    void start(double) noexcept {}
+    void update(const SearchProgress&) noexcept {}
+    void endStep(double) noexcept {}
+    void observeDelta(double) noexcept {}
+};
+
+}
+
+#endif // GENERIC_ACCEPTANCE_POLICY_HXX
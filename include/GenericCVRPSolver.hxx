@@ -1,6 +1,8 @@
 #ifndef GENERIC_CVRP_SOLVER_HXX
 #define GENERIC_CVRP_SOLVER_HXX
 
+#include <functional>
+
 #include <CVRPInstance.hxx>
 #include <CVRPSolution.hxx>
 #include <Meta.hxx>
@@ -8,6 +10,10 @@
 
 namespace Solver
 {
+
+// Called by the anytime solvers with each new best feasible solution, as soon as it is found. The solution borrows
+// the instance being solved : a copy kept after the instance is destroyed must be rebuilt from its data.
+using BestSolutionCallback = std::function<void(const CVRPSolution&)>;
     
 template<class Derived>
 class GenericCVRPSolver
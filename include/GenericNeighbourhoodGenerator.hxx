@@ -1,36 +1,134 @@
 #ifndef GENERIC_NEIGHBOURHOOD_GENERATOR_HXX
 #define GENERIC_NEIGHBOURHOOD_GENERATOR_HXX
 
-#include <CVRPSolution.hxx>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include <Meta.hxx>
+#include <SearchSolution.hxx>
 
 namespace Heuristic
 {
 
+// Outcome of the evaluation of a move, without applying it
+struct MoveEvaluation
+{
+    double distanceDelta;
+    size_t excessLoad; // Total excess load of the solution once the move is applied
+};
+
+// A neighbourhood describes its moves with a nested 'Move' type, and works against a SearchSolution :
+// - 'randomMove(solution, randomEngine, move)' draws a move, and returns false if there is none to draw
+// - 'evaluate(solution, move)' returns the MoveEvaluation of the move, in constant time
+// - 'apply(solution, move)' performs the move in place
+// - 'undo(solution, move)' reverts a move previously applied, the solution being left untouched in between
+// - 'forEachMove(solution, customer, visitor)' calls the visitor on every move involving the customer, until the
+//   visitor returns true, in which case it returns true as well. Every move of the neighbourhood is enumerated from
+//   at least one of the customers it involves.
+// When the solution has candidate lists attached, 'randomMove' and 'forEachMove' only generate moves creating an edge
+// between a customer and one of its candidates (granular mode), and all moves otherwise. Neighbourhoods relying on
+// the generic granular mode build these moves with 'granularMove(solution, customer, candidate, variant, move)',
+// for every variant below their 'granularVariants' constant.
+template<class Derived>
 class GenericNeighbourhoodGenerator
 {
-    private:
-    using CVRPSolution = Solver::CVRPSolution;
+    protected:
+    template<class T, class = void>
+    struct is_move_interface_implemented_in : std::false_type {};
+    
+    template<class T>
+    struct is_move_interface_implemented_in<T, Meta::void_t<
+        decltype(std::declval<const T&>().evaluate(std::declval<const SearchSolution&>(), std::declval<const typename T::Move&>())),
+        decltype(std::declval<T&>().apply(std::declval<SearchSolution&>(), std::declval<const typename T::Move&>())),
+        decltype(std::declval<T&>().undo(std::declval<SearchSolution&>(), std::declval<const typename T::Move&>()))>> : std::true_type {};
     
     public:
-    /*GenericNeighbourhoodGenerator(const CVRPSolution& solution)
-    : initial_{solution}
-    {}*/
-    GenericNeighbourhoodGenerator() = default;
+    GenericNeighbourhoodGenerator()
+    {
+        static_assert(is_move_interface_implemented_in<Derived>::value, "Invalid derived class : must define the type 'Move', and implement the methods 'evaluate', 'apply' and 'undo'");
+    }
     
     GenericNeighbourhoodGenerator(const GenericNeighbourhoodGenerator&) = default;
     GenericNeighbourhoodGenerator(GenericNeighbourhoodGenerator&&) = default;
     
     GenericNeighbourhoodGenerator& operator=(const GenericNeighbourhoodGenerator&) = default;
-    GenericNeighbourhoodGenerator& operator=(GenericNeighbourhoodGenerator&) = default;
+    GenericNeighbourhoodGenerator& operator=(GenericNeighbourhoodGenerator&&) = default;
+    
+    protected:
+    // Draws two distinct routes uniformly, returns false if there are not enough routes
+    template<class RandomEngine>
+    static bool pickTwoRoutes(const SearchSolution& solution, RandomEngine& randomEngine, size_t& route1, size_t& route2)
+    {
+        if(solution.getNumberOfRoutes() < 2)
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> routePicker1(0, solution.getNumberOfRoutes() - 1);
+        std::uniform_int_distribution<size_t> routePicker2(0, solution.getNumberOfRoutes() - 2);
+        
+        route1 = routePicker1(randomEngine);
+        route2 = routePicker2(randomEngine);
+        route2 += route2 >= route1 ? 1 : 0;
+        
+        return true;
+    }
     
-    //void setSolution(const CVRPSolution& solution) const noexcept { initial_ = solution; }
+    template<class RandomEngine, class Move>
+    bool randomGranularMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        SearchSolution::IdType customer;
+        SearchSolution::IdType candidate;
+        
+        if(!pickCandidateEdge(solution, randomEngine, customer, candidate))
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> variantPicker(0, Derived::granularVariants - 1);
+        return static_cast<const Derived&>(*this).granularMove(solution, customer, candidate, variantPicker(randomEngine), move);
+    }
     
-    CVRPSolution randomNeighbour() const; 
+    template<class Visitor>
+    bool forEachGranularMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor& visitor) const
+    {
+        const CandidateLists& candidateLists = *solution.getCandidateLists();
+        typename Derived::Move move;
+        
+        for(auto candidate = candidateLists.candidatesBegin(customer); candidate != candidateLists.candidatesEnd(customer); ++candidate)
+        {
+            for(size_t variant = 0; variant < Derived::granularVariants; ++variant)
+            {
+                if(static_cast<const Derived&>(*this).granularMove(solution, customer, *candidate, variant, move) && visitor(move))
+                {
+                    return true;
+                }
+            }
+        }
+        
+        return false;
+    }
     
-    private:
-    //CVRPSolution initial_;
+    // Draws a customer uniformly, and one of its candidates uniformly, for the granular mode
+    template<class RandomEngine>
+    static bool pickCandidateEdge(const SearchSolution& solution, RandomEngine& randomEngine, SearchSolution::IdType& customer, SearchSolution::IdType& candidate)
+    {
+        if(solution.getNumberOfCustomers() == 0)
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> customerPicker(0, solution.getNumberOfCustomers() - 1);
+        std::uniform_int_distribution<size_t> candidatePicker(0, solution.getCandidateLists()->getSize() - 1);
+        
+        customer = solution.getRoutes().customers()[customerPicker(randomEngine)];
+        candidate = solution.getCandidateLists()->getCandidate(customer, candidatePicker(randomEngine));
+        
+        return true;
+    }
 };
 
 }
 
-#endif // GENERIC_NEIGHBOURHOOD_GENERATOR_HXX
\ No newline at end of file
+#endif // GENERIC_NEIGHBOURHOOD_GENERATOR_HXX
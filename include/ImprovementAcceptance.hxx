@@ -0,0 +1,24 @@
+#ifndef IMPROVEMENT_ACCEPTANCE_HXX
+#define IMPROVEMENT_ACCEPTANCE_HXX
+
+#include <GenericAcceptancePolicy.hxx>
+
+namespace Heuristic
+{
+
+// Only accepts the neighbours strictly improving the cost : the search is a descent
+class ImprovementAcceptance : public GenericAcceptancePolicy<ImprovementAcceptance>
+{
+    public:
+    using GenericAcceptancePolicy::GenericAcceptancePolicy;
+    
+    template<class RandomEngine>
+    bool accept(double currentCost, double newCost, RandomEngine&) const noexcept
+    {
+        return newCost < currentCost;
+    }
+};
+
+}
+
+#endif // IMPROVEMENT_ACCEPTANCE_HXX
@@ -0,0 +1,189 @@
+#ifndef INSERTION_EVALUATOR_HXX
+#define INSERTION_EVALUATOR_HXX
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// Distance variations of inserting customers at every position of one route, in a single pass over flat data.
+// Loading a route copies its nodes, framed by the depot, and the costs of its edges. The variation of inserting a
+// customer u at position p is then
+//     delta[p] = c(u, node[p]) + c(u, node[p + 1]) - edge[p]
+// where the costs from u come from a single row of the cost matrix : the row is gathered along the route, four costs
+// at a time with AVX2 when the target supports it, and the deltas follow from a loop the compiler vectorises.
+// Once a route is loaded, the insertions of any number of customers in it are evaluated without touching it again.
+class InsertionEvaluator
+{
+    public:
+    using IdType = SearchSolution::IdType;
+    
+    // Routes with at most this number of insertion positions are searched with repeated scans in 'bestInsertions'
+    static constexpr size_t maxScannedPositions = 16;
+    
+    public:
+    InsertionEvaluator()
+    : solution_{nullptr},
+      nodes_{},
+      edges_{},
+      costsFromCustomer_{},
+      deltas_{}
+    {}
+    
+    InsertionEvaluator(const InsertionEvaluator&) = default;
+    InsertionEvaluator(InsertionEvaluator&&) = default;
+    
+    InsertionEvaluator& operator=(const InsertionEvaluator&) = default;
+    InsertionEvaluator& operator=(InsertionEvaluator&&) = default;
+    
+    // The solution must not change while its route is loaded
+    void loadRoute(const SearchSolution& solution, size_t route)
+    {
+        size_t size = solution.getRouteSize(route);
+        const IdType* customers = solution.getRoutes().routeBegin(route);
+        
+        solution_ = &solution;
+        nodes_.resize(size + 2);
+        edges_.resize(size + 1);
+        costsFromCustomer_.resize(size + 2);
+        deltas_.resize(size + 1);
+        
+        nodes_.front() = static_cast<int32_t>(solution.getDepot());
+        std::copy(customers, customers + size, nodes_.begin() + 1);
+        nodes_.back() = static_cast<int32_t>(solution.getDepot());
+        
+        for(size_t position = 0; position <= size; ++position)
+        {
+            edges_[position] = solution.costOf(nodes_[position], nodes_[position + 1]);
+        }
+    }
+    
+    // Number of insertion positions in the loaded route, its size plus one
+    size_t getNumberOfPositions() const noexcept
+    {
+        return edges_.size();
+    }
+    
+    // Variations of inserting the customer at every position of the loaded route, valid until the next call
+    double* computeDeltas(IdType customer) noexcept
+    {
+        const double* costs = solution_->costsFrom(customer);
+        size_t numberOfNodes = nodes_.size();
+        size_t i = 0;
+
+#if defined(__AVX2__)
+        for(; i + 4 <= numberOfNodes; i += 4)
+        {
+            __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nodes_.data() + i));
+            _mm256_storeu_pd(costsFromCustomer_.data() + i, _mm256_i32gather_pd(costs, indices, sizeof(double)));
+        }
+#endif
+
+        for(; i < numberOfNodes; ++i)
+        {
+            costsFromCustomer_[i] = costs[nodes_[i]];
+        }
+        
+        const double* from = costsFromCustomer_.data();
+        const double* edges = edges_.data();
+        double* deltas = deltas_.data();
+        size_t numberOfPositions = edges_.size();
+        
+        for(size_t position = 0; position < numberOfPositions; ++position)
+        {
+            deltas[position] = from[position] + from[position + 1] - edges[position];
+        }
+        
+        return deltas;
+    }
+    
+    // Writes the 'count' cheapest insertions of the customer in the loaded route, sorted by increasing cost, the first
+    // position winning ties, and returns how many were written, which is less than 'count' on short routes.
+    // On short routes, keeping a sorted list up to date mispredicts most of its branches, so each insertion comes from
+    // a scan for the minimum written without branches instead. On longer routes, most positions fail the comparison
+    // with the current worst insertion kept, and a single pass is faster.
+    size_t bestInsertions(IdType customer, size_t count, size_t* positions, double* deltas) noexcept
+    {
+        double* allDeltas = computeDeltas(customer);
+        size_t numberOfPositions = getNumberOfPositions();
+        size_t found = std::min(count, numberOfPositions);
+        
+        if(found == 0)
+        {
+            return 0;
+        }
+        
+        if(numberOfPositions <= maxScannedPositions)
+        {
+            for(size_t rank = 0; rank < found; ++rank)
+            {
+                size_t best = 0;
+                double bestDelta = allDeltas[0];
+                
+                for(size_t position = 1; position < numberOfPositions; ++position)
+                {
+                    bool better = allDeltas[position] < bestDelta;
+                    bestDelta = better ? allDeltas[position] : bestDelta;
+                    best = better ? position : best;
+                }
+                
+                positions[rank] = best;
+                deltas[rank] = bestDelta;
+                allDeltas[best] = std::numeric_limits<double>::infinity();
+            }
+            
+            return found;
+        }
+        
+        size_t kept = 0;
+        double threshold = std::numeric_limits<double>::infinity();
+        
+        for(size_t position = 0; position < numberOfPositions; ++position)
+        {
+            double delta = allDeltas[position];
+            
+            if(!(delta < threshold))
+            {
+                continue;
+            }
+            
+            size_t rank = kept < found ? kept++ : found - 1;
+            while(rank > 0 && delta < deltas[rank - 1])
+            {
+                deltas[rank] = deltas[rank - 1];
+                positions[rank] = positions[rank - 1];
+                --rank;
+            }
+            
+            deltas[rank] = delta;
+            positions[rank] = position;
+            
+            if(kept == found)
+            {
+                threshold = deltas[found - 1];
+            }
+        }
+        
+        return found;
+    }
+    
+    private:
+    const SearchSolution* solution_;
+    std::vector<int32_t> nodes_;
+    std::vector<double> edges_;
+    std::vector<double> costsFromCustomer_;
+    std::vector<double> deltas_;
+};
+
+}
+
+#endif // INSERTION_EVALUATOR_HXX
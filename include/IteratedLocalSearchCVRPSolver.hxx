@@ -0,0 +1,184 @@
+#ifndef ITERATED_LOCAL_SEARCH_CVRP_SOLVER_HXX
+#define ITERATED_LOCAL_SEARCH_CVRP_SOLVER_HXX
+
+#include <utility>
+
+#include <ActiveCustomerQueue.hxx>
+#include <AnytimeSolverSettings.hxx>
+#include <BestSolutionRecorder.hxx>
+#include <CandidateLists.hxx>
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <GenericAcceptancePolicy.hxx>
+#include <GenericCVRPSolver.hxx>
+#include <LocalSearch.hxx>
+#include <NeighbourhoodSearchSettings.hxx>
+#include <Perturbation.hxx>
+#include <RandomEngine.hxx>
+#include <SearchSolution.hxx>
+#include <TimeBudget.hxx>
+
+namespace Solver
+{
+
+// Iterated local search : the solution of the base solver is brought to a local optimum, which is then perturbed and
+// improved again at each iteration. The acceptance policy decides whether the search goes on from the new local
+// optimum or from the previous one, with the costs of both.
+// After each perturbation, the local search only starts from the customers around the changes. The elite solution,
+// the best feasible one met, is kept aside, and the search restarts from it after 'stagnationLimit' iterations
+// without improving it. As an iteration runs a whole local search, the time budget is checked after each one.
+template<class BaseSolver, class AcceptancePolicy, class ... Neighbourhoods>
+class IteratedLocalSearchCVRPSolver : public GenericCVRPSolver<IteratedLocalSearchCVRPSolver<BaseSolver, AcceptancePolicy, Neighbourhoods...>>,
+                                      public AnytimeSolverSettings,
+                                      public NeighbourhoodSearchSettings
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    
+    public:
+    static constexpr size_t defaultStagnationLimit = 1000;
+    
+    public:
+    IteratedLocalSearchCVRPSolver(const BaseSolver& baseSolver,
+                                  size_t iterations,
+                                  const AcceptancePolicy& acceptancePolicy = AcceptancePolicy{},
+                                  Heuristic::ImprovementStrategy strategy = Heuristic::ImprovementStrategy::FirstImprovement,
+                                  double wrongCapacityPenalty = CVRPSolutionCostProcessor::defaultWrongCapacityPenalty,
+                                  double repairCapacityPenalty = defaultRepairCapacityPenalty)
+    : GenericCVRPSolver<IteratedLocalSearchCVRPSolver>(),
+      AnytimeSolverSettings(1),
+      NeighbourhoodSearchSettings(repairCapacityPenalty),
+      baseSolver_{baseSolver},
+      iterations_{iterations},
+      acceptancePolicy_{acceptancePolicy},
+      localSearch_{strategy},
+      perturbation_{},
+      stagnationLimit_{defaultStagnationLimit},
+      wrongCapacityPenalty_{wrongCapacityPenalty},
+      performedIterations_{0},
+      restarts_{0}
+    {}
+    
+    void setAcceptancePolicy(const AcceptancePolicy& acceptancePolicy)
+    {
+        acceptancePolicy_ = acceptancePolicy;
+    }
+    
+    // Policy of the last run, holding its final state
+    const AcceptancePolicy& getAcceptancePolicy() const noexcept
+    {
+        return acceptancePolicy_;
+    }
+    
+    void setPerturbation(const Heuristic::Perturbation& perturbation) noexcept
+    {
+        perturbation_ = perturbation;
+    }
+    
+    const Heuristic::Perturbation& getPerturbation() const noexcept
+    {
+        return perturbation_;
+    }
+    
+    // Zero never restarts from the elite solution
+    void setStagnationLimit(size_t stagnationLimit) noexcept
+    {
+        stagnationLimit_ = stagnationLimit;
+    }
+    
+    size_t getStagnationLimit() const noexcept
+    {
+        return stagnationLimit_;
+    }
+    
+    // Number of iterations and of restarts from the elite solution of the last run
+    size_t getPerformedIterations() const noexcept { return performedIterations_; }
+    size_t getRestarts() const noexcept { return restarts_; }
+    
+    CVRPSolution solve(const CVRPInstance& instance)
+    {
+        Heuristic::RandomEngine randomEngine = startRandomEngine();
+        
+        auto origSol = baseSolver_.solve(instance);
+        Heuristic::SearchSolution current{instance, origSol.getData()};
+        
+        Heuristic::CandidateLists candidateLists = createCandidateLists(instance);
+        configure(current, candidateLists);
+        
+        TimeBudget timeBudget = startTimeBudget();
+        
+        CVRPSolutionCostProcessor costProcessor{wrongCapacityPenalty_};
+        localSearch_.improve(current, costProcessor);
+        
+        // The elite solution is kept whole, as the search restarts from it
+        Heuristic::SearchSolution candidate = current;
+        Heuristic::SearchSolution elite = current;
+        BestSolutionRecorder best{instance, getBestSolutionCallback(), Heuristic::LocalSearch<Neighbourhoods...>::improvementThreshold};
+        best.record(current);
+        
+        Heuristic::ActiveCustomerQueue perturbedCustomers{instance.getNumberOfNodes()};
+        size_t stagnation = 0;
+        restarts_ = 0;
+        acceptancePolicy_.start(current.getCost(costProcessor));
+        
+        for(performedIterations_ = 0; performedIterations_ < iterations_ && !timeBudget.isExhausted(); ++performedIterations_)
+        {
+            acceptancePolicy_.update(progressOf(performedIterations_, iterations_, timeBudget));
+            
+            candidate = current;
+            candidate.setActiveCustomers(&perturbedCustomers);
+            perturbation_.apply(candidate, randomEngine);
+            candidate.setActiveCustomers(nullptr);
+            localSearch_.improveFrom(candidate, costProcessor, perturbedCustomers);
+            
+            if(candidate.getExcessLoad() == current.getExcessLoad())
+            {
+                acceptancePolicy_.observeDelta(candidate.getDistance() - current.getDistance());
+            }
+            
+            if(acceptancePolicy_.accept(current.getCost(costProcessor), candidate.getCost(costProcessor), randomEngine))
+            {
+                std::swap(current, candidate);
+            }
+            
+            ++stagnation;
+            if(best.record(current))
+            {
+                elite = current;
+                stagnation = 0;
+            }
+            else if(stagnation == stagnationLimit_ && best.hasSolution())
+            {
+                current = elite;
+                stagnation = 0;
+                ++restarts_;
+            }
+            
+            acceptancePolicy_.endStep(current.getCost(costProcessor));
+        }
+        
+        if(!best.hasSolution())
+        {
+            getRepairPenaltyController().applyTo(costProcessor);
+            localSearch_.improve(current, costProcessor);
+            return {instance, current.toSolutionData()};
+        }
+        
+        return best.toSolution();
+    }
+    
+    private:
+    BaseSolver baseSolver_;
+    size_t iterations_;
+    AcceptancePolicy acceptancePolicy_;
+    Heuristic::LocalSearch<Neighbourhoods...> localSearch_;
+    Heuristic::Perturbation perturbation_;
+    size_t stagnationLimit_;
+    double wrongCapacityPenalty_;
+    size_t performedIterations_;
+    size_t restarts_;
+};
+
+}
+
+#endif // ITERATED_LOCAL_SEARCH_CVRP_SOLVER_HXX
@@ -0,0 +1,61 @@
+#ifndef LATE_ACCEPTANCE_HXX
+#define LATE_ACCEPTANCE_HXX
+
+#include <algorithm>
+#include <vector>
+
+#include <GenericAcceptancePolicy.hxx>
+
+namespace Heuristic
+{
+
+// Late Acceptance Hill Climbing (Burke and Bykov, 2017) : a neighbour is accepted if it is no worse than the current
+// solution, or than the current solution of 'historyLength' steps ago. The costs of the last steps are kept in a
+// circular history, filled with the initial cost at the beginning of a run.
+// The only parameter is the length of the history : the longer it is, the longer the search explores before it
+// converges, a history of length 1 making it a descent accepting neutral neighbours.
+class LateAcceptance : public GenericAcceptancePolicy<LateAcceptance>
+{
+    public:
+    static constexpr size_t defaultHistoryLength = 1000;
+    
+    public:
+    explicit LateAcceptance(size_t historyLength = defaultHistoryLength)
+    : history_(std::max(historyLength, size_t{1}), 0.0),
+      index_{0}
+    {}
+    
+    LateAcceptance(const LateAcceptance&) = default;
+    LateAcceptance(LateAcceptance&&) = default;
+    
+    LateAcceptance& operator=(const LateAcceptance&) = default;
+    LateAcceptance& operator=(LateAcceptance&&) = default;
+    
+    size_t getHistoryLength() const noexcept { return history_.size(); }
+    
+    void start(double initialCost)
+    {
+        std::fill(history_.begin(), history_.end(), initialCost);
+        index_ = 0;
+    }
+    
+    template<class RandomEngine>
+    bool accept(double currentCost, double newCost, RandomEngine&) const noexcept
+    {
+        return (newCost <= currentCost) | (newCost <= history_[index_]);
+    }
+    
+    void endStep(double currentCost) noexcept
+    {
+        history_[index_] = currentCost;
+        index_ = index_ + 1 == history_.size() ? 0 : index_ + 1;
+    }
+    
+    private:
+    std::vector<double> history_;
+    size_t index_;
+};
+
+}
+
+#endif // LATE_ACCEPTANCE_HXX
@@ -0,0 +1,209 @@
+#ifndef LOCAL_SEARCH_HXX
+#define LOCAL_SEARCH_HXX
+
+#include <tuple>
+#include <utility>
+
+#include <ActiveCustomerQueue.hxx>
+#include <CVRPSolution.hxx>
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+enum class ImprovementStrategy
+{
+    FirstImprovement, // Applies the first improving move found around a customer
+    BestImprovement   // Applies the best move around a customer, over all the neighbourhoods
+};
+
+// Systematic local search : the active customers are scanned one at a time, every move involving them being
+// enumerated in every neighbourhood. A customer stays inactive after a scan without improvement, until one of its
+// neighbours changes.
+// As reactivating the neighbours of the modified edges does not catch every move which became improving elsewhere,
+// the search ends with a sweep over all the customers, and only stops once such a sweep does not improve anything :
+// the solution is then exactly a local optimum of all the neighbourhoods.
+template<class ... Neighbourhoods>
+class LocalSearch
+{
+    private:
+    using CostProcessor = Solver::CVRPSolutionCostProcessor;
+    using IdType = SearchSolution::IdType;
+    using NeighbourhoodTupleType = std::tuple<Neighbourhoods...>;
+    using MoveTupleType = std::tuple<typename Neighbourhoods::Move...>;
+    
+    public:
+    // Moves must improve the cost by more than this, so that rounding errors never make the search cycle
+    static constexpr double improvementThreshold = 1e-9;
+    
+    public:
+    explicit LocalSearch(ImprovementStrategy strategy = ImprovementStrategy::FirstImprovement)
+    : strategy_{strategy},
+      activeCustomers_{0},
+      neighbourhoods_{}
+    {}
+    
+    LocalSearch(const LocalSearch&) = default;
+    LocalSearch(LocalSearch&&) = default;
+    
+    LocalSearch& operator=(const LocalSearch&) = default;
+    LocalSearch& operator=(LocalSearch&&) = default;
+    
+    ImprovementStrategy getStrategy() const noexcept { return strategy_; }
+    void setStrategy(ImprovementStrategy strategy) noexcept { strategy_ = strategy; }
+    
+    // Improves the solution in place until it is a local optimum, and returns the number of improving moves applied
+    size_t improve(SearchSolution& solution, const CostProcessor& costProcessor)
+    {
+        if(activeCustomers_.capacity() != solution.getInstance().getNumberOfNodes())
+        {
+            activeCustomers_ = ActiveCustomerQueue{solution.getInstance().getNumberOfNodes()};
+        }
+        
+        ActiveCustomerQueue* previousActiveCustomers = solution.getActiveCustomers();
+        solution.setActiveCustomers(&activeCustomers_);
+        
+        size_t improvements = 0;
+        size_t sweepImprovements;
+        
+        do
+        {
+            solution.activateAllCustomers();
+            sweepImprovements = improveActiveCustomers(solution, costProcessor);
+            improvements += sweepImprovements;
+        } while(sweepImprovements != 0);
+        
+        solution.setActiveCustomers(previousActiveCustomers);
+        
+        return improvements;
+    }
+    
+    // Improves the solution in place from the customers of the queue, which is emptied, typically those whose
+    // surroundings a perturbation changed, and from the customers whose surroundings change in turn. Without the final
+    // sweeps, the solution is only a local optimum around the changes, at a fraction of the cost of 'improve'.
+    size_t improveFrom(SearchSolution& solution, const CostProcessor& costProcessor, ActiveCustomerQueue& customers)
+    {
+        if(activeCustomers_.capacity() != solution.getInstance().getNumberOfNodes())
+        {
+            activeCustomers_ = ActiveCustomerQueue{solution.getInstance().getNumberOfNodes()};
+        }
+        
+        while(!customers.empty())
+        {
+            activeCustomers_.activate(customers.pop());
+        }
+        
+        ActiveCustomerQueue* previousActiveCustomers = solution.getActiveCustomers();
+        solution.setActiveCustomers(&activeCustomers_);
+        
+        size_t improvements = improveActiveCustomers(solution, costProcessor);
+        
+        solution.setActiveCustomers(previousActiveCustomers);
+        
+        return improvements;
+    }
+    
+    private:
+    size_t improveActiveCustomers(SearchSolution& solution, const CostProcessor& costProcessor)
+    {
+        size_t improvements = 0;
+        
+        while(!activeCustomers_.empty())
+        {
+            IdType customer = activeCustomers_.pop();
+            
+            if(improveAround(solution, costProcessor, customer))
+            {
+                activeCustomers_.activate(customer);
+                ++improvements;
+            }
+        }
+        
+        return improvements;
+    }
+    
+    bool improveAround(SearchSolution& solution, const CostProcessor& costProcessor, IdType customer)
+    {
+        double targetCost = solution.getCost(costProcessor) - improvementThreshold;
+        
+        if(strategy_ == ImprovementStrategy::FirstImprovement)
+        {
+            return improveFirst(solution, costProcessor, customer, targetCost, std::index_sequence_for<Neighbourhoods...>{});
+        }
+        
+        return improveBest(solution, costProcessor, customer, targetCost, std::index_sequence_for<Neighbourhoods...>{});
+    }
+    
+    template<size_t ... indices>
+    bool improveFirst(SearchSolution& solution, const CostProcessor& costProcessor, IdType customer, double targetCost, std::index_sequence<indices...>)
+    {
+        MoveTupleType moves;
+        return (applyImprovingIn(std::get<indices>(neighbourhoods_), solution, costProcessor, customer, targetCost, std::get<indices>(moves), true) || ...);
+    }
+    
+    template<size_t ... indices>
+    bool improveBest(SearchSolution& solution, const CostProcessor& costProcessor, IdType customer, double targetCost, std::index_sequence<indices...>)
+    {
+        MoveTupleType moves;
+        size_t bestIndex = sizeof...(Neighbourhoods);
+        
+        // Each neighbourhood lowers the target cost to the cost of its best move, so the last one found is the best overall
+        ((findImprovingIn(std::get<indices>(neighbourhoods_), solution, costProcessor, customer, targetCost, std::get<indices>(moves), false) ? void(bestIndex = indices) : void()), ...);
+        
+        if(bestIndex == sizeof...(Neighbourhoods))
+        {
+            return false;
+        }
+        
+        ((bestIndex == indices ? std::get<indices>(neighbourhoods_).apply(solution, std::get<indices>(moves)) : void()), ...);
+        return true;
+    }
+    
+    template<class Neighbourhood>
+    static bool applyImprovingIn(const Neighbourhood& neighbourhood, SearchSolution& solution, const CostProcessor& costProcessor, IdType customer,
+                                 double targetCost, typename Neighbourhood::Move& move, bool firstImprovement)
+    {
+        if(!findImprovingIn(neighbourhood, solution, costProcessor, customer, targetCost, move, firstImprovement))
+        {
+            return false;
+        }
+        
+        neighbourhood.apply(solution, move);
+        return true;
+    }
+    
+    // Looks for a move whose cost is below the target among the moves involving the customer, the first one found
+    // or the best one, and lowers the target to its cost
+    template<class Neighbourhood>
+    static bool findImprovingIn(const Neighbourhood& neighbourhood, const SearchSolution& solution, const CostProcessor& costProcessor, IdType customer,
+                                double& targetCost, typename Neighbourhood::Move& bestMove, bool firstImprovement)
+    {
+        bool found = false;
+        
+        neighbourhood.forEachMove(solution, customer, [&](const typename Neighbourhood::Move& move)
+        {
+            auto evaluation = neighbourhood.evaluate(solution, move);
+            double cost = costProcessor.computeCost(solution.getDistance() + evaluation.distanceDelta, evaluation.excessLoad);
+            
+            if(cost < targetCost)
+            {
+                targetCost = cost;
+                bestMove = move;
+                found = true;
+            }
+            
+            return found && firstImprovement;
+        });
+        
+        return found;
+    }
+    
+    ImprovementStrategy strategy_;
+    ActiveCustomerQueue activeCustomers_;
+    NeighbourhoodTupleType neighbourhoods_;
+};
+
+}
+
+#endif // LOCAL_SEARCH_HXX
@@ -0,0 +1,64 @@
+#ifndef LOCAL_SEARCH_CVRP_SOLVER_HXX
+#define LOCAL_SEARCH_CVRP_SOLVER_HXX
+
+#include <CandidateLists.hxx>
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <GenericCVRPSolver.hxx>
+#include <LocalSearch.hxx>
+#include <NeighbourhoodSearchSettings.hxx>
+#include <SearchSolution.hxx>
+
+namespace Solver
+{
+
+// Improves the solution of the base solver with a systematic local search, until it reaches a local optimum of all
+// the neighbourhoods. If that optimum violates the capacity, the search goes on with the repair penalty.
+template<class BaseSolver, class ... Neighbourhoods>
+class LocalSearchCVRPSolver : public GenericCVRPSolver<LocalSearchCVRPSolver<BaseSolver, Neighbourhoods...>>,
+                              public NeighbourhoodSearchSettings
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    
+    public:
+    LocalSearchCVRPSolver(const BaseSolver& baseSolver,
+                          Heuristic::ImprovementStrategy strategy = Heuristic::ImprovementStrategy::FirstImprovement,
+                          double wrongCapacityPenalty = CVRPSolutionCostProcessor::defaultWrongCapacityPenalty,
+                          double repairCapacityPenalty = defaultRepairCapacityPenalty)
+    : GenericCVRPSolver<LocalSearchCVRPSolver>(),
+      NeighbourhoodSearchSettings(repairCapacityPenalty),
+      baseSolver_{baseSolver},
+      localSearch_{strategy},
+      wrongCapacityPenalty_{wrongCapacityPenalty}
+    {}
+    
+    CVRPSolution solve(const CVRPInstance& instance)
+    {
+        auto origSol = baseSolver_.solve(instance);
+        Heuristic::SearchSolution solution{instance, origSol.getData()};
+        
+        Heuristic::CandidateLists candidateLists = createCandidateLists(instance);
+        configure(solution, candidateLists);
+        
+        CVRPSolutionCostProcessor costProcessor{wrongCapacityPenalty_};
+        localSearch_.improve(solution, costProcessor);
+        
+        if(!solution.isFeasible())
+        {
+            getRepairPenaltyController().applyTo(costProcessor);
+            localSearch_.improve(solution, costProcessor);
+        }
+        
+        return {instance, solution.toSolutionData()};
+    }
+    
+    private:
+    BaseSolver baseSolver_;
+    Heuristic::LocalSearch<Neighbourhoods...> localSearch_;
+    double wrongCapacityPenalty_;
+};
+
+}
+
+#endif // LOCAL_SEARCH_CVRP_SOLVER_HXX
@@ -0,0 +1,89 @@
+#ifndef NEIGHBOURHOOD_SEARCH_SETTINGS_HXX
+#define NEIGHBOURHOOD_SEARCH_SETTINGS_HXX
+
+#include <CandidateLists.hxx>
+#include <CapacityPenaltyController.hxx>
+#include <CVRPInstance.hxx>
+#include <SearchSolution.hxx>
+
+namespace Solver
+{
+
+// Settings shared by the solvers exploring the neighbourhoods of a Heuristic::SearchSolution, which derive from this
+// class : the granularity, the route pruning, and the penalty of the capacity repair ending the run when the solution
+// still violates the capacity.
+class NeighbourhoodSearchSettings
+{
+    public:
+    static constexpr double defaultRepairCapacityPenalty = 1000000.0;
+    
+    public:
+    explicit NeighbourhoodSearchSettings(double repairCapacityPenalty = defaultRepairCapacityPenalty) noexcept
+    : repairPenaltyController_{repairCapacityPenalty},
+      granularity_{0},
+      routePruning_{false}
+    {}
+    
+    NeighbourhoodSearchSettings(const NeighbourhoodSearchSettings&) = default;
+    NeighbourhoodSearchSettings(NeighbourhoodSearchSettings&&) = default;
+    
+    NeighbourhoodSearchSettings& operator=(const NeighbourhoodSearchSettings&) = default;
+    NeighbourhoodSearchSettings& operator=(NeighbourhoodSearchSettings&&) = default;
+    
+    // With a non zero granularity, only the moves creating an edge between a customer and one of its 'granularity'
+    // nearest customers are considered
+    void setGranularity(size_t granularity) noexcept
+    {
+        granularity_ = granularity;
+    }
+    
+    size_t getGranularity() const noexcept
+    {
+        return granularity_;
+    }
+    
+    // Heuristic pruning of the pairs of distant routes, which may skip improving moves, see
+    // Heuristic::SearchSolution::setRoutePruning
+    void setRoutePruning(bool routePruning) noexcept
+    {
+        routePruning_ = routePruning;
+    }
+    
+    bool isRoutePruningEnabled() const noexcept
+    {
+        return routePruning_;
+    }
+    
+    // The repair never adapts its penalty, which dominates the cost
+    const CapacityPenaltyController& getRepairPenaltyController() const noexcept
+    {
+        return repairPenaltyController_;
+    }
+    
+    protected:
+    // Candidate lists of the instance, empty without granularity
+    Heuristic::CandidateLists createCandidateLists(const Data::CVRPInstance& instance) const
+    {
+        return {instance, granularity_};
+    }
+    
+    // The solution keeps a pointer to the candidate lists, which must outlive its search
+    void configure(Heuristic::SearchSolution& solution, const Heuristic::CandidateLists& candidateLists) const noexcept
+    {
+        solution.setRoutePruning(routePruning_);
+        
+        if(granularity_ != 0)
+        {
+            solution.setCandidateLists(&candidateLists);
+        }
+    }
+    
+    private:
+    CapacityPenaltyController repairPenaltyController_;
+    size_t granularity_;
+    bool routePruning_;
+};
+
+}
+
+#endif // NEIGHBOURHOOD_SEARCH_SETTINGS_HXX
@@ -0,0 +1,91 @@
+#ifndef NEIGHBOURHOOD_STATISTICS_HXX
+#define NEIGHBOURHOOD_STATISTICS_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+namespace Heuristic
+{
+
+// Counters of a neighbourhood over a run :
+// - proposed : moves requested from the neighbourhood
+// - evaluated : moves actually drawn and evaluated
+// - improving : evaluated moves which would lower the cost
+// - accepted : moves applied to the solution, along with the total cost decrease brought by the improving ones
+// Reading the clock around every step would cost as much as a step itself, so only one step out of
+// 'timingPeriod' is timed, and the total time is extrapolated from these samples.
+struct NeighbourhoodStatistics
+{
+    using ClockType = std::chrono::steady_clock;
+    
+    static constexpr uint64_t timingPeriod = 16;
+    
+    bool shouldTime() const noexcept
+    {
+        return proposed % timingPeriod == 0;
+    }
+    
+    void addTimeSample(ClockType::duration duration) noexcept
+    {
+        sampledTime += std::chrono::duration<double>(duration).count();
+        ++timedSteps;
+    }
+    
+    double getEstimatedTime() const noexcept
+    {
+        return timedSteps == 0 ? 0.0 : sampledTime * proposed / timedSteps;
+    }
+    
+    // Moves proposed per second of time spent in the neighbourhood, which compares the throughput of its uniform and
+    // granular modes
+    double getMovesPerSecond() const noexcept
+    {
+        double time = getEstimatedTime();
+        return time == 0.0 ? 0.0 : proposed / time;
+    }
+    
+    double getAcceptanceRate() const noexcept
+    {
+        return evaluated == 0 ? 0.0 : static_cast<double>(accepted) / evaluated;
+    }
+    
+    NeighbourhoodStatistics& operator+=(const NeighbourhoodStatistics& other) noexcept
+    {
+        proposed += other.proposed;
+        evaluated += other.evaluated;
+        improving += other.improving;
+        accepted += other.accepted;
+        totalGain += other.totalGain;
+        sampledTime += other.getEstimatedTime();
+        timedSteps += other.proposed;
+        return *this;
+    }
+    
+    void print(std::ostream& os, const char* name) const
+    {
+        os << std::left << std::setw(16) << name << std::right
+           << " proposed " << std::setw(10) << proposed
+           << " evaluated " << std::setw(10) << evaluated
+           << " improving " << std::setw(8) << improving
+           << " accepted " << std::setw(8) << accepted
+           << " (" << std::fixed << std::setprecision(3) << 100.0 * getAcceptanceRate() << "%)"
+           << " gain " << std::setprecision(1) << totalGain
+           << " time " << std::setprecision(4) << getEstimatedTime() << "s"
+           << " (" << std::setprecision(0) << getMovesPerSecond() << " moves/s)"
+           << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+    
+    uint64_t proposed = 0;
+    uint64_t evaluated = 0;
+    uint64_t improving = 0;
+    uint64_t accepted = 0;
+    double totalGain = 0.0;
+    double sampledTime = 0.0;
+    uint64_t timedSteps = 0;
+};
+
+}
+
+#endif // NEIGHBOURHOOD_STATISTICS_HXX
@@ -3,60 +3,125 @@
 
 #include <random>
 
-#include <CVRPInstance.hxx>
 #include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
 
 namespace Heuristic
 {
-    
-class OnePointExtraNeighbourhood : public GenericNeighbourhoodGenerator
+
+// Relocation of a single customer, anywhere in the solution
+class OnePointExtraNeighbourhood : public GenericNeighbourhoodGenerator<OnePointExtraNeighbourhood>
 {
-    private:
-    using CVRPSolutionData = Solver::CVRPSolutionData;
     public:
-    using GenericNeighbourhoodGenerator::GenericNeighbourhoodGenerator;
+    // The destination position is expressed in the destination route once the customer has been removed
+    struct Move
+    {
+        size_t fromRoute;
+        size_t fromPosition;
+        size_t toRoute;
+        size_t toPosition;
+    };
+    
+    // The customer is moved right before or right after its candidate
+    static constexpr size_t granularVariants = 2;
+    
+    static constexpr const char* name = "relocate";
     
     public:
-    CVRPSolutionData randomNeighbour(const CVRPSolutionData& sol)
+    using GenericNeighbourhoodGenerator::GenericNeighbourhoodGenerator;
+    
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
     {
-        if(sol.size() == 0)
+        if(solution.isGranular())
         {
-            return {};
+            return randomGranularMove(solution, randomEngine, move);
         }
         
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> routePicker(0, sol.size() - 1); 
+        if(solution.getNumberOfCustomers() == 0)
+        {
+            return false;
+        }
         
-        auto newData = sol;
+        std::uniform_int_distribution<size_t> routePicker(0, solution.getNumberOfRoutes() - 1);
         
-        auto r1 = 0;
-        do 
+        do
         {
-            r1 = routePicker(gen);
-        } while(sol[r1].size() == 0);
+            move.fromRoute = routePicker(randomEngine);
+        } while(solution.getRouteSize(move.fromRoute) == 0);
         
-        std::uniform_int_distribution<> nodePicker1(0, sol[r1].size() - 1);
-        auto n1Id = nodePicker1(gen);
+        std::uniform_int_distribution<size_t> nodePicker1(0, solution.getRouteSize(move.fromRoute) - 1);
+        move.fromPosition = nodePicker1(randomEngine);
         
-        auto n1It = newData[r1].begin() + n1Id;
-        auto n1 = *n1It;
-        newData[r1].erase(n1It);
+        move.toRoute = routePicker(randomEngine);
+        std::uniform_int_distribution<size_t> nodePicker2(0, solution.getRouteSize(move.toRoute) - (move.fromRoute == move.toRoute ? 1 : 0));
+        move.toPosition = nodePicker2(randomEngine);
+        
+        return true;
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        return {solution.relocationDelta(move.fromRoute, move.fromPosition, move.toRoute, move.toPosition),
+                solution.relocationExcessLoad(move.fromRoute, move.fromPosition, move.toRoute)};
+    }
+    
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.relocate(move.fromRoute, move.fromPosition, move.toRoute, move.toPosition);
+    }
+    
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.relocate(move.toRoute, move.toPosition, move.fromRoute, move.fromPosition);
+    }
+    
+    // Every position of every route
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor&& visitor) const
+    {
+        if(solution.isGranular())
+        {
+            return forEachGranularMove(solution, customer, visitor);
+        }
         
-        auto r2 = routePicker(gen);
-        std::uniform_int_distribution<> nodePicker2(0, newData[r2].size());
-        auto n2Id = nodePicker2(gen);
+        Move move;
+        move.fromRoute = solution.routeOf(customer);
+        move.fromPosition = solution.positionOf(customer);
         
-        auto n2It = newData[r2].begin() + n2Id;
+        for(move.toRoute = 0; move.toRoute < solution.getNumberOfRoutes(); ++move.toRoute)
+        {
+            size_t toSize = solution.getRouteSize(move.toRoute) - (move.fromRoute == move.toRoute ? 1 : 0);
+            
+            for(move.toPosition = 0; move.toPosition <= toSize; ++move.toPosition)
+            {
+                if((move.fromRoute != move.toRoute || move.fromPosition != move.toPosition) && visitor(move))
+                {
+                    return true;
+                }
+            }
+        }
         
-        newData[r2].insert(n2It, n1);
+        return false;
+    }
+    
+    bool granularMove(const SearchSolution& solution, SearchSolution::IdType customer, SearchSolution::IdType candidate, size_t variant, Move& move) const noexcept
+    {
+        move.fromRoute = solution.routeOf(customer);
+        move.fromPosition = solution.positionOf(customer);
+        move.toRoute = solution.routeOf(candidate);
         
-        // std::cout << "Switch " << sol.getOriginalInstance().idOf(n1) << " from route " << r1 << " to " << r2 << " position " << n2Id << std::endl;
+        size_t candidatePosition = solution.positionOf(candidate);
+        if(move.fromRoute == move.toRoute && move.fromPosition < candidatePosition)
+        {
+            --candidatePosition;
+        }
+        move.toPosition = candidatePosition + variant;
         
-        return newData;
+        return true;
     }
 };
 
 }
 
-#endif // ONE_POINT_EXTRA_NEIGHBOURHOOD_HXX
\ No newline at end of file
+#endif // ONE_POINT_EXTRA_NEIGHBOURHOOD_HXX
@@ -0,0 +1,175 @@
+#ifndef OR_OPT_NEIGHBOURHOOD_HXX
+#define OR_OPT_NEIGHBOURHOOD_HXX
+
+#include <algorithm>
+#include <random>
+
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// Or-opt : a chain of one to 'maxSegmentLength' consecutive customers is moved elsewhere in its route, or to another route,
+// and possibly reversed. Only the three edges around the removal and insertion points change, and the load of the chain
+// comes from the prefix loads, so evaluating a move is constant time.
+template<size_t maxSegmentLength = 3>
+class OrOptNeighbourhood : public GenericNeighbourhoodGenerator<OrOptNeighbourhood<maxSegmentLength>>
+{
+    private:
+    using Base = GenericNeighbourhoodGenerator<OrOptNeighbourhood<maxSegmentLength>>;
+    
+    public:
+    // The destination position is expressed in the destination route once the chain has been removed
+    struct Move
+    {
+        size_t fromRoute;
+        size_t begin;
+        size_t length;
+        size_t toRoute;
+        size_t toPosition;
+        bool reversed;
+    };
+    
+    // The chain is inserted right after the candidate, and starts with the customer once inserted : the customer is
+    // the first element of the chain, or the last one if the chain is reversed. Variants span lengths and orientations.
+    static constexpr size_t granularVariants = 2 * maxSegmentLength;
+    
+    static constexpr const char* name = "or-opt";
+    
+    public:
+    using Base::Base;
+    
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        if(solution.isGranular())
+        {
+            return Base::randomGranularMove(solution, randomEngine, move);
+        }
+        
+        if(solution.getNumberOfCustomers() == 0)
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> routePicker(0, solution.getNumberOfRoutes() - 1);
+        
+        do
+        {
+            move.fromRoute = routePicker(randomEngine);
+        } while(solution.getRouteSize(move.fromRoute) == 0);
+        
+        size_t fromSize = solution.getRouteSize(move.fromRoute);
+        std::uniform_int_distribution<size_t> lengthPicker(1, std::min(maxSegmentLength, fromSize));
+        move.length = lengthPicker(randomEngine);
+        
+        std::uniform_int_distribution<size_t> beginPicker(0, fromSize - move.length);
+        move.begin = beginPicker(randomEngine);
+        
+        move.toRoute = routePicker(randomEngine);
+        std::uniform_int_distribution<size_t> positionPicker(0, solution.getRouteSize(move.toRoute) - (move.fromRoute == move.toRoute ? move.length : 0));
+        move.toPosition = positionPicker(randomEngine);
+        
+        // Reversing a single customer changes nothing
+        move.reversed = move.length > 1 && std::bernoulli_distribution{}(randomEngine);
+        
+        return true;
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        return {solution.segmentMoveDelta(move.fromRoute, move.begin, move.begin + move.length, move.toRoute, move.toPosition, move.reversed),
+                solution.segmentMoveExcessLoad(move.fromRoute, move.begin, move.begin + move.length, move.toRoute)};
+    }
+    
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.moveSegment(move.fromRoute, move.begin, move.begin + move.length, move.toRoute, move.toPosition, move.reversed);
+    }
+    
+    // Moving the chain back, reversing it again if needed, restores the routes
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.moveSegment(move.toRoute, move.toPosition, move.toPosition + move.length, move.fromRoute, move.begin, move.reversed);
+    }
+    
+    // Chains starting with the customer, in both orientations, inserted at every position of every route
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor&& visitor) const
+    {
+        if(solution.isGranular())
+        {
+            return Base::forEachGranularMove(solution, customer, visitor);
+        }
+        
+        Move move;
+        move.fromRoute = solution.routeOf(customer);
+        move.begin = solution.positionOf(customer);
+        
+        size_t maxLength = std::min(maxSegmentLength, solution.getRouteSize(move.fromRoute) - move.begin);
+        
+        for(move.length = 1; move.length <= maxLength; ++move.length)
+        {
+            for(move.toRoute = 0; move.toRoute < solution.getNumberOfRoutes(); ++move.toRoute)
+            {
+                size_t toSize = solution.getRouteSize(move.toRoute) - (move.fromRoute == move.toRoute ? move.length : 0);
+                
+                for(move.toPosition = 0; move.toPosition <= toSize; ++move.toPosition)
+                {
+                    move.reversed = false;
+                    if((move.fromRoute != move.toRoute || move.begin != move.toPosition) && visitor(move))
+                    {
+                        return true;
+                    }
+                    
+                    move.reversed = true;
+                    if(move.length > 1 && visitor(move))
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+        
+        return false;
+    }
+    
+    bool granularMove(const SearchSolution& solution, SearchSolution::IdType customer, SearchSolution::IdType candidate, size_t variant, Move& move) const noexcept
+    {
+        move.fromRoute = solution.routeOf(customer);
+        move.toRoute = solution.routeOf(candidate);
+        move.length = variant / 2 + 1;
+        move.reversed = variant % 2 == 1;
+        
+        size_t fromSize = solution.getRouteSize(move.fromRoute);
+        size_t position = solution.positionOf(customer);
+        size_t candidatePosition = solution.positionOf(candidate);
+        
+        if((move.reversed && move.length == 1) || (move.reversed ? position + 1 < move.length : position + move.length > fromSize))
+        {
+            return false;
+        }
+        move.begin = move.reversed ? position + 1 - move.length : position;
+        
+        if(move.fromRoute == move.toRoute)
+        {
+            if(candidatePosition >= move.begin && candidatePosition < move.begin + move.length)
+            {
+                return false;
+            }
+            
+            if(candidatePosition >= move.begin + move.length)
+            {
+                candidatePosition -= move.length;
+            }
+        }
+        move.toPosition = candidatePosition + 1;
+        
+        return true;
+    }
+};
+
+}
+
+#endif // OR_OPT_NEIGHBOURHOOD_HXX
@@ -0,0 +1,150 @@
+#ifndef PARALLEL_MULTI_START_CVRP_SOLVER_HXX
+#define PARALLEL_MULTI_START_CVRP_SOLVER_HXX
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <AnytimeSolverSettings.hxx>
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <GenericCVRPSolver.hxx>
+
+namespace Solver
+{
+
+// Runs copies of an anytime solver in parallel threads, one per worker, and returns the best solution among theirs.
+// All workers start from the seed of the solver, each one on its own stream of it, so that a run bounded by iterations
+// rather than by time is reproducible for a given seed and number of workers.
+// The callback only receives the solutions shorter than all those found so far by any worker. It is called from the
+// worker threads, but never from two of them at once.
+template<class Solver>
+class ParallelMultiStartCVRPSolver : public GenericCVRPSolver<ParallelMultiStartCVRPSolver<Solver>>
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    
+    static_assert(std::is_base_of<AnytimeSolverSettings, Solver>::value, "Invalid solver : must derive from AnytimeSolverSettings");
+    
+    public:
+    // Zero workers stand for one per hardware thread
+    explicit ParallelMultiStartCVRPSolver(const Solver& solver, size_t numberOfWorkers = 0)
+    : GenericCVRPSolver<ParallelMultiStartCVRPSolver>(),
+      solver_{solver},
+      numberOfWorkers_{numberOfWorkers != 0 ? numberOfWorkers : std::max(std::thread::hardware_concurrency(), 1u)},
+      bestSolutionCallback_{}
+    {}
+    
+    // Settings of the workers, except for their stream and their callback
+    Solver& getSolver() noexcept
+    {
+        return solver_;
+    }
+    
+    const Solver& getSolver() const noexcept
+    {
+        return solver_;
+    }
+    
+    size_t getNumberOfWorkers() const noexcept
+    {
+        return numberOfWorkers_;
+    }
+    
+    void setBestSolutionCallback(BestSolutionCallback callback)
+    {
+        bestSolutionCallback_ = std::move(callback);
+    }
+    
+    CVRPSolution solve(const CVRPInstance& instance)
+    {
+        std::vector<Solver> workers(numberOfWorkers_, solver_);
+        std::vector<CVRPSolutionData> results(numberOfWorkers_);
+        std::vector<std::exception_ptr> errors(numberOfWorkers_);
+        std::vector<std::thread> threads;
+        threads.reserve(numberOfWorkers_);
+        
+        std::mutex callbackMutex;
+        double bestDistance = std::numeric_limits<double>::infinity();
+        CVRPSolutionCostProcessor costProcessor;
+        
+        for(size_t worker = 0; worker < numberOfWorkers_; ++worker)
+        {
+            workers[worker].setStream(worker);
+            workers[worker].setBestSolutionCallback([&](const CVRPSolution& solution)
+            {
+                std::lock_guard<std::mutex> lock{callbackMutex};
+                double distance = costProcessor.computeDistance(instance, solution.getData());
+                
+                if(distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    
+                    if(bestSolutionCallback_)
+                    {
+                        bestSolutionCallback_(solution);
+                    }
+                }
+            });
+        }
+        
+        for(size_t worker = 0; worker < numberOfWorkers_; ++worker)
+        {
+            threads.emplace_back([&, worker]()
+            {
+                try
+                {
+                    results[worker] = workers[worker].solve(instance).getData();
+                }
+                catch(...)
+                {
+                    errors[worker] = std::current_exception();
+                }
+            });
+        }
+        
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        
+        for(const std::exception_ptr& error : errors)
+        {
+            if(error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+        
+        // Feasible solutions first, then by cost, the first worker winning ties
+        auto rank = [&](const CVRPSolutionData& data)
+        {
+            return std::make_pair(costProcessor.computeExcessLoad(instance, data) != 0, costProcessor.computeCost(instance, data));
+        };
+        
+        size_t bestWorker = 0;
+        for(size_t worker = 1; worker < numberOfWorkers_; ++worker)
+        {
+            if(rank(results[worker]) < rank(results[bestWorker]))
+            {
+                bestWorker = worker;
+            }
+        }
+        
+        return {instance, std::move(results[bestWorker])};
+    }
+    
+    private:
+    Solver solver_;
+    size_t numberOfWorkers_;
+    BestSolutionCallback bestSolutionCallback_;
+};
+
+}
+
+#endif // PARALLEL_MULTI_START_CVRP_SOLVER_HXX
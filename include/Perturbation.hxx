@@ -0,0 +1,154 @@
+#ifndef PERTURBATION_HXX
+#define PERTURBATION_HXX
+
+#include <algorithm>
+#include <random>
+
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+enum class PerturbationType
+{
+    RandomRelocations, // Moves 'strength' random customers to random positions of random routes
+    DoubleBridge,      // Applies 'strength' double bridges, each one exchanging two consecutive segments of a random route
+    SegmentShuffle,    // Shuffles a segment of 'strength' customers of a random route
+    Mixed              // One of the above, drawn uniformly at each perturbation
+};
+
+// Kicks a local optimum out of its basin of attraction, as the perturbation step of an iterated local search.
+// The changes go through the primitives of the solution, so that the customers around them are activated when a queue
+// is attached to it, and ignore the capacities, left to the penalty of the local search which follows.
+class Perturbation
+{
+    private:
+    using IdType = SearchSolution::IdType;
+    
+    public:
+    static constexpr size_t defaultStrength = 3;
+    
+    public:
+    explicit Perturbation(PerturbationType type = PerturbationType::Mixed, size_t strength = defaultStrength) noexcept
+    : type_{type},
+      strength_{std::max(strength, size_t{1})}
+    {}
+    
+    Perturbation(const Perturbation&) = default;
+    Perturbation(Perturbation&&) = default;
+    
+    Perturbation& operator=(const Perturbation&) = default;
+    Perturbation& operator=(Perturbation&&) = default;
+    
+    PerturbationType getType() const noexcept { return type_; }
+    size_t getStrength() const noexcept { return strength_; }
+    
+    template<class RandomEngine>
+    void apply(SearchSolution& solution, RandomEngine& randomEngine) const
+    {
+        if(solution.getNumberOfCustomers() < 2)
+        {
+            return;
+        }
+        
+        PerturbationType type = type_;
+        if(type == PerturbationType::Mixed)
+        {
+            type = static_cast<PerturbationType>(std::uniform_int_distribution<int>{0, 2}(randomEngine));
+        }
+        
+        switch(type)
+        {
+            case PerturbationType::RandomRelocations:
+                relocateRandomly(solution, randomEngine);
+                break;
+            case PerturbationType::DoubleBridge:
+                applyDoubleBridges(solution, randomEngine);
+                break;
+            default:
+                shuffleSegment(solution, randomEngine);
+                break;
+        }
+    }
+    
+    private:
+    template<class RandomEngine>
+    static IdType randomCustomer(const SearchSolution& solution, RandomEngine& randomEngine)
+    {
+        return solution.getRoutes().customers()[std::uniform_int_distribution<size_t>{0, solution.getNumberOfCustomers() - 1}(randomEngine)];
+    }
+    
+    template<class RandomEngine>
+    void relocateRandomly(SearchSolution& solution, RandomEngine& randomEngine) const
+    {
+        std::uniform_int_distribution<size_t> routePicker(0, solution.getNumberOfRoutes() - 1);
+        
+        for(size_t i = 0; i < strength_; ++i)
+        {
+            IdType customer = randomCustomer(solution, randomEngine);
+            size_t fromRoute = solution.routeOf(customer);
+            size_t toRoute = routePicker(randomEngine);
+            size_t lastPosition = solution.getRouteSize(toRoute) - (toRoute == fromRoute ? 1 : 0);
+            
+            solution.relocate(fromRoute, solution.positionOf(customer), toRoute, std::uniform_int_distribution<size_t>{0, lastPosition}(randomEngine));
+        }
+    }
+    
+    // A route a b c d, cut in four parts, becomes a c b d, b and c being non empty. Routes of a single customer are skipped.
+    template<class RandomEngine>
+    void applyDoubleBridges(SearchSolution& solution, RandomEngine& randomEngine) const
+    {
+        for(size_t i = 0; i < strength_; ++i)
+        {
+            size_t route = solution.routeOf(randomCustomer(solution, randomEngine));
+            size_t size = solution.getRouteSize(route);
+            
+            if(size < 2)
+            {
+                continue;
+            }
+            
+            size_t cuts[3];
+            std::uniform_int_distribution<size_t> cutPicker(0, size);
+            
+            do
+            {
+                for(size_t& cut : cuts)
+                {
+                    cut = cutPicker(randomEngine);
+                }
+                
+                std::sort(cuts, cuts + 3);
+            } while(cuts[0] == cuts[1] || cuts[1] == cuts[2]);
+            
+            solution.moveSegment(route, cuts[1], cuts[2], route, cuts[0], false);
+        }
+    }
+    
+    // Fisher-Yates shuffle, the customer drawn for each position of the segment being relocated there
+    template<class RandomEngine>
+    void shuffleSegment(SearchSolution& solution, RandomEngine& randomEngine) const
+    {
+        size_t route = solution.routeOf(randomCustomer(solution, randomEngine));
+        size_t size = solution.getRouteSize(route);
+        size_t length = std::min(strength_, size);
+        size_t begin = std::uniform_int_distribution<size_t>{0, size - length}(randomEngine);
+        
+        for(size_t last = begin + length; last-- > begin + 1;)
+        {
+            size_t drawn = std::uniform_int_distribution<size_t>{begin, last}(randomEngine);
+            
+            if(drawn != last)
+            {
+                solution.relocate(route, drawn, route, last);
+            }
+        }
+    }
+    
+    PerturbationType type_;
+    size_t strength_;
+};
+
+}
+
+#endif // PERTURBATION_HXX
@@ -0,0 +1,88 @@
+#ifndef POLAR_SECTOR_HXX
+#define POLAR_SECTOR_HXX
+
+#include <cmath>
+#include <cstdint>
+
+#include <Coordinates.hxx>
+
+namespace Heuristic
+{
+
+// Angular sector, seen from the depot, covering a set of customers. Angles are discretized on 16 bits, so that
+// the arithmetic modulo a full turn is the natural unsigned overflow.
+// Extending a sector keeps it as narrow as possible, by growing it on the side closest to the new angle.
+class PolarSector
+{
+    public:
+    using AngleType = uint16_t;
+    
+    public:
+    PolarSector() noexcept
+    : start_{0},
+      end_{0},
+      empty_{true}
+    {}
+    
+    PolarSector(const PolarSector&) = default;
+    PolarSector(PolarSector&&) = default;
+    
+    PolarSector& operator=(const PolarSector&) = default;
+    PolarSector& operator=(PolarSector&&) = default;
+    
+    static AngleType angleOf(Coordinates point, Coordinates origin) noexcept
+    {
+        double angle = std::atan2(point.y - origin.y, point.x - origin.x);
+        return static_cast<AngleType>(static_cast<int32_t>(std::lround(angle * 32768.0 / M_PI)) & 0xFFFF);
+    }
+    
+    bool isEmpty() const noexcept { return empty_; }
+    AngleType getStart() const noexcept { return start_; }
+    AngleType getEnd() const noexcept { return end_; }
+    
+    bool contains(AngleType angle) const noexcept
+    {
+        return !empty_ && static_cast<AngleType>(angle - start_) <= static_cast<AngleType>(end_ - start_);
+    }
+    
+    void extend(AngleType angle) noexcept
+    {
+        if(empty_)
+        {
+            start_ = end_ = angle;
+            empty_ = false;
+        }
+        else if(!contains(angle))
+        {
+            if(static_cast<AngleType>(angle - end_) <= static_cast<AngleType>(start_ - angle))
+            {
+                end_ = angle;
+            }
+            else
+            {
+                start_ = angle;
+            }
+        }
+    }
+    
+    void clear() noexcept
+    {
+        empty_ = true;
+    }
+    
+    bool overlaps(const PolarSector& other) const noexcept
+    {
+        return !empty_ && !other.empty_
+            && (static_cast<AngleType>(other.start_ - start_) <= static_cast<AngleType>(end_ - start_)
+             || static_cast<AngleType>(start_ - other.start_) <= static_cast<AngleType>(other.end_ - other.start_));
+    }
+    
+    private:
+    AngleType start_;
+    AngleType end_;
+    bool empty_;
+};
+
+}
+
+#endif // POLAR_SECTOR_HXX
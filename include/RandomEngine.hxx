@@ -0,0 +1,128 @@
+#ifndef RANDOM_ENGINE_HXX
+#define RANDOM_ENGINE_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Heuristic
+{
+
+// xoshiro256** (Blackman and Vigna, 2018) : a 256 bits state, a few cycles per draw, and a period of 2^256 - 1.
+// It satisfies the UniformRandomBitGenerator requirements, so the standard distributions work with it.
+// The state is expanded from a 64 bits seed with SplitMix64, so that runs started from the same seed draw the same
+// sequence. 'jump' advances the engine by 2^128 draws, which splits a seed in independent streams, one per worker.
+class Xoshiro256StarStar
+{
+    public:
+    using result_type = uint64_t;
+    
+    public:
+    explicit Xoshiro256StarStar(uint64_t seed) noexcept
+    : state_{}
+    {
+        this->seed(seed);
+    }
+    
+    Xoshiro256StarStar(const Xoshiro256StarStar&) = default;
+    Xoshiro256StarStar(Xoshiro256StarStar&&) = default;
+    
+    Xoshiro256StarStar& operator=(const Xoshiro256StarStar&) = default;
+    Xoshiro256StarStar& operator=(Xoshiro256StarStar&&) = default;
+    
+    // Engine drawing the 'stream'-th sequence of the seed, streams being 2^128 draws apart
+    static Xoshiro256StarStar forStream(uint64_t seed, size_t stream) noexcept
+    {
+        Xoshiro256StarStar engine{seed};
+        
+        for(size_t i = 0; i < stream; ++i)
+        {
+            engine.jump();
+        }
+        
+        return engine;
+    }
+    
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+    
+    void seed(uint64_t seed) noexcept
+    {
+        for(uint64_t& word : state_)
+        {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            word = z ^ (z >> 31);
+        }
+    }
+    
+    result_type operator()() noexcept
+    {
+        uint64_t result = rotateLeft(state_[1] * 5, 7) * 9;
+        uint64_t t = state_[1] << 17;
+        
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotateLeft(state_[3], 45);
+        
+        return result;
+    }
+    
+    // Equivalent to 2^128 draws
+    void jump() noexcept
+    {
+        static constexpr uint64_t polynomial[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+        uint64_t jumped[4] = {0, 0, 0, 0};
+        
+        for(uint64_t word : polynomial)
+        {
+            for(unsigned int bit = 0; bit < 64; ++bit)
+            {
+                if(word & (uint64_t{1} << bit))
+                {
+                    for(size_t i = 0; i < 4; ++i)
+                    {
+                        jumped[i] ^= state_[i];
+                    }
+                }
+                
+                (*this)();
+            }
+        }
+        
+        for(size_t i = 0; i < 4; ++i)
+        {
+            state_[i] = jumped[i];
+        }
+    }
+    
+    bool operator==(const Xoshiro256StarStar& other) const noexcept
+    {
+        return state_[0] == other.state_[0] && state_[1] == other.state_[1] && state_[2] == other.state_[2] && state_[3] == other.state_[3];
+    }
+    
+    bool operator!=(const Xoshiro256StarStar& other) const noexcept
+    {
+        return !(*this == other);
+    }
+    
+    private:
+    static uint64_t rotateLeft(uint64_t x, int k) noexcept
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+    
+    uint64_t state_[4];
+};
+
+// Engine of the stochastic components
+using RandomEngine = Xoshiro256StarStar;
+
+}
+
+#endif // RANDOM_ENGINE_HXX
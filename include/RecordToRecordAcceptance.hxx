@@ -0,0 +1,62 @@
+#ifndef RECORD_TO_RECORD_ACCEPTANCE_HXX
+#define RECORD_TO_RECORD_ACCEPTANCE_HXX
+
+#include <algorithm>
+
+#include <GenericAcceptancePolicy.hxx>
+
+namespace Heuristic
+{
+
+// Record-to-Record Travel (Dueck, 1993) : a neighbour is accepted if it improves the current solution, or if its cost
+// stays below the record, the lowest cost met during the run, increased by 'deviation' times the record.
+// The threshold only moves when the record does, so it is computed once per step in 'endStep' rather than on every
+// evaluated neighbour.
+class RecordToRecordAcceptance : public GenericAcceptancePolicy<RecordToRecordAcceptance>
+{
+    public:
+    static constexpr double defaultDeviation = 0.002;
+    
+    public:
+    explicit RecordToRecordAcceptance(double deviation = defaultDeviation) noexcept
+    : deviation_{deviation},
+      record_{0.0},
+      threshold_{0.0}
+    {}
+    
+    RecordToRecordAcceptance(const RecordToRecordAcceptance&) = default;
+    RecordToRecordAcceptance(RecordToRecordAcceptance&&) = default;
+    
+    RecordToRecordAcceptance& operator=(const RecordToRecordAcceptance&) = default;
+    RecordToRecordAcceptance& operator=(RecordToRecordAcceptance&&) = default;
+    
+    double getDeviation() const noexcept { return deviation_; }
+    double getRecord() const noexcept { return record_; }
+    
+    void start(double initialCost) noexcept
+    {
+        record_ = initialCost;
+        threshold_ = (1.0 + deviation_) * record_;
+    }
+    
+    template<class RandomEngine>
+    bool accept(double currentCost, double newCost, RandomEngine&) const noexcept
+    {
+        return (newCost < currentCost) | (newCost < threshold_);
+    }
+    
+    void endStep(double currentCost) noexcept
+    {
+        record_ = std::min(record_, currentCost);
+        threshold_ = (1.0 + deviation_) * record_;
+    }
+    
+    private:
+    double deviation_;
+    double record_;
+    double threshold_;
+};
+
+}
+
+#endif // RECORD_TO_RECORD_ACCEPTANCE_HXX
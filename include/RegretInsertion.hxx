@@ -0,0 +1,173 @@
+#ifndef REGRET_INSERTION_HXX
+#define REGRET_INSERTION_HXX
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <InsertionEvaluator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// Repair step of a large neighbourhood search : inserts the unassigned customers back, one at a time, each at its
+// cheapest position. With a regret level k, the customer inserted next is the one maximising
+//     sum over i = 2..k of (c_i - c_1)
+// where c_i is the cost of its best insertion in the route ranked i-th for it, ties going to the lowest c_1. The
+// level 1 is the greedy insertion, the cheapest insertion overall being performed first.
+// The cost of an insertion is its distance variation plus the penalty of the excess load it adds, and the cost of the
+// best insertion of every customer in every route is cached : inserting a customer only changes its route, so only
+// the costs in that route are evaluated again, all the customers at once with the InsertionEvaluator.
+class RegretInsertion
+{
+    private:
+    using IdType = SearchSolution::IdType;
+    
+    public:
+    static constexpr size_t maxRegretLevel = 4;
+    
+    public:
+    RegretInsertion()
+    : evaluator_{},
+      customers_{},
+      costs_{},
+      positions_{}
+    {}
+    
+    RegretInsertion(const RegretInsertion&) = default;
+    RegretInsertion(RegretInsertion&&) = default;
+    
+    RegretInsertion& operator=(const RegretInsertion&) = default;
+    RegretInsertion& operator=(RegretInsertion&&) = default;
+    
+    // Levels beyond maxRegretLevel count as maxRegretLevel
+    template<class CostProcessor>
+    void apply(SearchSolution& solution, size_t regretLevel, const CostProcessor& costProcessor)
+    {
+        size_t numberOfRoutes = solution.getNumberOfRoutes();
+        size_t level = std::min(std::max(regretLevel, size_t{1}), std::min(maxRegretLevel, numberOfRoutes));
+        
+        if(numberOfRoutes == 0)
+        {
+            return;
+        }
+        
+        customers_.assign(solution.getRoutes().unassignedBegin(), solution.getRoutes().unassignedEnd());
+        costs_.resize(customers_.size() * numberOfRoutes);
+        positions_.resize(customers_.size() * numberOfRoutes);
+        
+        for(size_t route = 0; route < numberOfRoutes; ++route)
+        {
+            evaluateRoute(solution, route, costProcessor);
+        }
+        
+        while(!customers_.empty())
+        {
+            size_t index = 0;
+            size_t route = 0;
+            selectInsertion(numberOfRoutes, level, index, route);
+            
+            solution.assign(customers_[index], route, positions_[index * numberOfRoutes + route]);
+            
+            size_t last = customers_.size() - 1;
+            if(index != last)
+            {
+                customers_[index] = customers_[last];
+                std::copy(costs_.begin() + last * numberOfRoutes, costs_.begin() + (last + 1) * numberOfRoutes, costs_.begin() + index * numberOfRoutes);
+                std::copy(positions_.begin() + last * numberOfRoutes, positions_.begin() + (last + 1) * numberOfRoutes, positions_.begin() + index * numberOfRoutes);
+            }
+            
+            customers_.pop_back();
+            costs_.resize(customers_.size() * numberOfRoutes);
+            positions_.resize(customers_.size() * numberOfRoutes);
+            
+            evaluateRoute(solution, route, costProcessor);
+        }
+    }
+    
+    private:
+    // Best insertion of every remaining customer in the route
+    template<class CostProcessor>
+    void evaluateRoute(const SearchSolution& solution, size_t route, const CostProcessor& costProcessor)
+    {
+        if(customers_.empty())
+        {
+            return;
+        }
+        
+        size_t numberOfRoutes = solution.getNumberOfRoutes();
+        size_t load = solution.getRouteLoad(route);
+        size_t excess = solution.getLoads().getExcessOf(route);
+        
+        evaluator_.loadRoute(solution, route);
+        
+        for(size_t index = 0; index < customers_.size(); ++index)
+        {
+            size_t position = 0;
+            double delta = 0.0;
+            evaluator_.bestInsertions(customers_[index], 1, &position, &delta);
+            
+            size_t addedExcess = solution.getLoads().getExcessOfLoad(load + solution.demandOf(customers_[index])) - excess;
+            costs_[index * numberOfRoutes + route] = costProcessor.computeCost(delta, addedExcess);
+            positions_[index * numberOfRoutes + route] = position;
+        }
+    }
+    
+    void selectInsertion(size_t numberOfRoutes, size_t level, size_t& selectedIndex, size_t& selectedRoute) const noexcept
+    {
+        double bestRegret = -1.0;
+        double bestCost = std::numeric_limits<double>::infinity();
+        
+        for(size_t index = 0; index < customers_.size(); ++index)
+        {
+            const double* costs = costs_.data() + index * numberOfRoutes;
+            double cheapest[maxRegretLevel];
+            size_t cheapestRoute = 0;
+            std::fill(cheapest, cheapest + level, std::numeric_limits<double>::infinity());
+            
+            for(size_t route = 0; route < numberOfRoutes; ++route)
+            {
+                double cost = costs[route];
+                
+                if(!(cost < cheapest[level - 1]))
+                {
+                    continue;
+                }
+                
+                size_t rank = level - 1;
+                while(rank > 0 && cost < cheapest[rank - 1])
+                {
+                    cheapest[rank] = cheapest[rank - 1];
+                    --rank;
+                }
+                
+                cheapest[rank] = cost;
+                cheapestRoute = rank == 0 ? route : cheapestRoute;
+            }
+            
+            double regret = 0.0;
+            for(size_t rank = 1; rank < level; ++rank)
+            {
+                regret += cheapest[rank] - cheapest[0];
+            }
+            
+            if(regret > bestRegret || (regret == bestRegret && cheapest[0] < bestCost))
+            {
+                bestRegret = regret;
+                bestCost = cheapest[0];
+                selectedIndex = index;
+                selectedRoute = cheapestRoute;
+            }
+        }
+    }
+    
+    InsertionEvaluator evaluator_;
+    std::vector<IdType> customers_;
+    std::vector<double> costs_;
+    std::vector<size_t> positions_;
+};
+
+}
+
+#endif // REGRET_INSERTION_HXX
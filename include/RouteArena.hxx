@@ -0,0 +1,128 @@
+#ifndef ROUTE_ARENA_HXX
+#define ROUTE_ARENA_HXX
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Solver
+{
+
+// Per-thread pool of uint32_t blocks, used as backing storage for route containers.
+// Blocks are rounded up to a power of two and recycled through one free list per size class,
+// so that once the pool is warm, copying and destroying route containers never hits the heap.
+// A block must be given back to the arena of the thread it was taken from, and must not outlive this thread.
+class RouteArena
+{
+    private:
+    static constexpr size_t numberOfSizeClasses = 32;
+    static constexpr size_t chunkSize = size_t{1} << 16;
+    
+    public:
+    RouteArena() noexcept
+    : current_{nullptr},
+      remaining_{0},
+      upstreamAllocations_{0},
+      arenaAllocations_{0}
+    {
+        freeLists_.fill(nullptr);
+    }
+    
+    RouteArena(const RouteArena&) = delete;
+    RouteArena(RouteArena&&) = delete;
+    
+    RouteArena& operator=(const RouteArena&) = delete;
+    RouteArena& operator=(RouteArena&&) = delete;
+    
+    static RouteArena& local() noexcept
+    {
+        thread_local RouteArena arena;
+        return arena;
+    }
+    
+    // Returns a block of at least 'count' elements. The actual capacity of the block is written to 'capacity',
+    // and must be given back when deallocating it.
+    uint32_t* allocate(size_t count, size_t& capacity)
+    {
+        size_t sizeClass = sizeClassOf(count);
+        capacity = size_t{1} << sizeClass;
+        ++arenaAllocations_;
+        
+        if(freeLists_[sizeClass] != nullptr)
+        {
+            uint32_t* block = freeLists_[sizeClass];
+            std::memcpy(&freeLists_[sizeClass], block, sizeof(uint32_t*));
+            return block;
+        }
+        
+        if(capacity > chunkSize)
+        {
+            return allocateChunk(capacity);
+        }
+        
+        if(remaining_ < capacity)
+        {
+            current_ = allocateChunk(chunkSize);
+            remaining_ = chunkSize;
+        }
+        
+        uint32_t* block = current_;
+        current_ += capacity;
+        remaining_ -= capacity;
+        
+        return block;
+    }
+    
+    void deallocate(uint32_t* block, size_t capacity) noexcept
+    {
+        if(block == nullptr)
+        {
+            return;
+        }
+        
+        size_t sizeClass = sizeClassOf(capacity);
+        std::memcpy(block, &freeLists_[sizeClass], sizeof(uint32_t*));
+        freeLists_[sizeClass] = block;
+    }
+    
+    // Number of blocks actually requested to the heap, versus number of blocks served by the arena
+    size_t getUpstreamAllocations() const noexcept { return upstreamAllocations_; }
+    size_t getArenaAllocations() const noexcept { return arenaAllocations_; }
+    
+    private:
+    static size_t sizeClassOf(size_t count) noexcept
+    {
+        // A free block must at least be able to hold the free list pointer, hence the two elements minimum
+        size_t sizeClass = 1;
+        
+        while((size_t{1} << sizeClass) < count)
+        {
+            ++sizeClass;
+        }
+        
+        return sizeClass;
+    }
+    
+    uint32_t* allocateChunk(size_t count)
+    {
+        // Chunks are made of 64 bits words, so that every block is suitably aligned to hold the free list pointer
+        chunks_.emplace_back(new uint64_t[(count + 1) / 2]);
+        ++upstreamAllocations_;
+        
+        return reinterpret_cast<uint32_t*>(chunks_.back().get());
+    }
+    
+    std::vector<std::unique_ptr<uint64_t[]>> chunks_;
+    std::array<uint32_t*, numberOfSizeClasses> freeLists_;
+    uint32_t* current_;
+    size_t remaining_;
+    
+    size_t upstreamAllocations_;
+    size_t arenaAllocations_;
+};
+
+}
+
+#endif // ROUTE_ARENA_HXX
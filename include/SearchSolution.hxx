@@ -0,0 +1,486 @@
+#ifndef SEARCH_SOLUTION_HXX
+#define SEARCH_SOLUTION_HXX
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <ActiveCustomerQueue.hxx>
+#include <BoundingBox.hxx>
+#include <CandidateLists.hxx>
+#include <CompactRoutes.hxx>
+#include <CostEvaluationKernel.hxx>
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <PolarSector.hxx>
+
+namespace Heuristic
+{
+
+// Working solution of the local search algorithms : the compact routes, along with the route loads,
+// the prefix loads and distances of every route, the location of every customer, and the total distance,
+// which are all updated in place by the primitive moves below.
+// Neighbourhoods propose moves against it, evaluate them in constant time, and only modify it
+// through these primitives when a move is accepted.
+class SearchSolution
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    using CVRPSolutionData = Solver::CVRPSolutionData;
+    using CVRPRouteLoads = Solver::CVRPRouteLoads;
+    using CompactRoutes = Solver::CompactRoutes;
+    using CostProcessor = Solver::CVRPSolutionCostProcessor;
+    
+    public:
+    using IdType = CompactRoutes::IdType;
+    
+    // Route of the customers taken out of the routes by 'unassign'
+    static constexpr IdType unassignedRoute = std::numeric_limits<IdType>::max();
+    
+    public:
+    SearchSolution(const CVRPInstance& instance, const CVRPSolutionData& data)
+    : instance_{&instance},
+      routes_{instance, data},
+      loads_{instance, data},
+      costMatrix_{instance.getCostMatrix().data()},
+      numberOfNodes_{instance.getNumberOfNodes()},
+      depot_{static_cast<IdType>(instance.idOfDepot())},
+      distance_{Solver::CostEvaluationKernel::computeDistance(instance, routes_)},
+      prefixLoads_(routes_.getNumberOfCustomers()),
+      prefixDistances_(routes_.getNumberOfCustomers()),
+      coordinates_(numberOfNodes_),
+      polarAngles_(numberOfNodes_),
+      routeSectors_(routes_.getNumberOfRoutes()),
+      routeBoxes_(routes_.getNumberOfRoutes()),
+      routePruning_{false},
+      routeOf_(numberOfNodes_),
+      positionOf_(numberOfNodes_),
+      candidateLists_{nullptr},
+      activeCustomers_{nullptr}
+    {
+        auto depotCoordinates = instance.getCoordinatesOf(instance.getNode(depot_));
+        for(size_t id = 0; id < numberOfNodes_; ++id)
+        {
+            coordinates_[id] = instance.getCoordinatesOf(instance.getNode(id));
+            polarAngles_[id] = PolarSector::angleOf(coordinates_[id], depotCoordinates);
+        }
+        
+        if(getNumberOfRoutes() != 0)
+        {
+            refreshRoutes(0, getNumberOfRoutes() - 1);
+        }
+        
+        for(size_t route = 0; route < getNumberOfRoutes(); ++route)
+        {
+            refreshGeometry(route);
+        }
+    }
+    
+    SearchSolution(const SearchSolution&) = default;
+    SearchSolution(SearchSolution&&) = default;
+    
+    SearchSolution& operator=(const SearchSolution&) = default;
+    SearchSolution& operator=(SearchSolution&&) = default;
+    
+    const CVRPInstance& getInstance() const noexcept { return *instance_; }
+    const CompactRoutes& getRoutes() const noexcept { return routes_; }
+    const CVRPRouteLoads& getLoads() const noexcept { return loads_; }
+    
+    double getDistance() const noexcept { return distance_; }
+    size_t getExcessLoad() const noexcept { return loads_.getExcessLoad(); }
+    bool isFeasible() const noexcept { return loads_.isFeasible(); }
+    double getCost(const CostProcessor& costProcessor) const noexcept { return costProcessor.computeCost(distance_, getExcessLoad()); }
+    
+    size_t getNumberOfRoutes() const noexcept { return routes_.getNumberOfRoutes(); }
+    size_t getNumberOfCustomers() const noexcept { return routes_.getNumberOfCustomers(); }
+    size_t getRouteSize(size_t route) const noexcept { return routes_.getRouteSize(route); }
+    IdType getCustomer(size_t route, size_t position) const noexcept { return routes_.getCustomer(route, position); }
+    IdType getDepot() const noexcept { return depot_; }
+    
+    // Load (resp. distance from the depot) of the first 'position' customers of the route, position ranging from 0 to the route size
+    size_t getPrefixLoad(size_t route, size_t position) const noexcept { return position == 0 ? 0 : prefixLoads_[routes_.getRouteOffset(route) + position - 1]; }
+    double getPrefixDistance(size_t route, size_t position) const noexcept { return position == 0 ? 0.0 : prefixDistances_[routes_.getRouteOffset(route) + position - 1]; }
+    
+    size_t getRouteLoad(size_t route) const noexcept { return loads_.getLoadOf(route); }
+    double getRouteDistance(size_t route) const noexcept
+    {
+        size_t size = getRouteSize(route);
+        return size == 0 ? 0.0 : getPrefixDistance(route, size) + costOf(getCustomer(route, size - 1), depot_);
+    }
+    
+    double costOf(IdType from, IdType to) const noexcept { return costMatrix_[from * numberOfNodes_ + to]; }
+    // Row of the cost matrix : costs from the node to every node, indexed by node ids
+    const double* costsFrom(IdType from) const noexcept { return costMatrix_ + from * numberOfNodes_; }
+    size_t demandOf(IdType customer) const noexcept { return instance_->getDemandOfId(customer); }
+    
+    // Current route and position of a customer
+    size_t routeOf(IdType customer) const noexcept { return routeOf_[customer]; }
+    size_t positionOf(IdType customer) const noexcept { return positionOf_[customer]; }
+    
+    // Customers out of every route, between 'unassign' and 'assign'. The distance and the loads only account for the
+    // assigned customers, and the neighbourhoods must not be used on such a partial solution.
+    size_t getNumberOfUnassigned() const noexcept { return routes_.getNumberOfUnassigned(); }
+    size_t getNumberOfAssigned() const noexcept { return getNumberOfCustomers() - getNumberOfUnassigned(); }
+    bool isAssigned(IdType customer) const noexcept { return routeOf_[customer] != unassignedRoute; }
+    
+    // Once candidate lists are attached, which must outlive the solution, neighbourhoods only draw granular moves
+    void setCandidateLists(const CandidateLists* candidateLists) noexcept { candidateLists_ = candidateLists; }
+    const CandidateLists* getCandidateLists() const noexcept { return candidateLists_; }
+    bool isGranular() const noexcept { return candidateLists_ != nullptr && candidateLists_->getSize() != 0; }
+    
+    // Once a queue is attached, which must outlive the solution, the primitives below activate the customers
+    // at both ends of every edge they modify
+    void setActiveCustomers(ActiveCustomerQueue* activeCustomers) noexcept { activeCustomers_ = activeCustomers; }
+    ActiveCustomerQueue* getActiveCustomers() const noexcept { return activeCustomers_; }
+    
+    void activateAllCustomers() noexcept
+    {
+        for(const IdType* customer = routes_.customers(); customer != routes_.customers() + getNumberOfCustomers(); ++customer)
+        {
+            activate(*customer);
+        }
+    }
+    
+    // Angle of the customer around the depot, and geometry of the routes, which is kept up to date by the primitives
+    PolarSector::AngleType polarAngleOf(IdType customer) const noexcept { return polarAngles_[customer]; }
+    const PolarSector& getRouteSector(size_t route) const noexcept { return routeSectors_[route]; }
+    const BoundingBox& getRouteBox(size_t route) const noexcept { return routeBoxes_[route]; }
+    
+    // Whether both routes have customers, and overlap both in polar sector and in bounding box
+    bool routesOverlap(size_t route1, size_t route2) const noexcept
+    {
+        return routeSectors_[route1].overlaps(routeSectors_[route2]) && routeBoxes_[route1].overlaps(routeBoxes_[route2]);
+    }
+    
+    // When route pruning is enabled, the swap, CROSS-exchange and 2-opt* neighbourhoods skip the pairs of non empty
+    // routes which do not overlap. This is a heuristic : disjoint sectors and boxes do not prove that no move between
+    // the two routes improves the solution, they only make it unlikely, so some improving moves may be skipped.
+    // The relocation, Or-opt and ejection chain neighbourhoods ignore it, and SWAP* always applies the overlap test.
+    void setRoutePruning(bool routePruning) noexcept { routePruning_ = routePruning; }
+    bool isRoutePruningEnabled() const noexcept { return routePruning_; }
+    bool canSkipRoutePair(size_t route1, size_t route2) const noexcept
+    {
+        return routePruning_ && getRouteSize(route1) != 0 && getRouteSize(route2) != 0 && !routesOverlap(route1, route2);
+    }
+    
+    // Node visited before (resp. after) the given position of the route, the depot at both ends
+    IdType predecessorOf(size_t route, size_t position) const noexcept { return position == 0 ? depot_ : routes_.getCustomer(route, position - 1); }
+    IdType successorOf(size_t route, size_t position) const noexcept { return position + 1 >= routes_.getRouteSize(route) ? depot_ : routes_.getCustomer(route, position + 1); }
+    
+    // Distance variation of CompactRoutes::relocate, with the same conventions
+    double relocationDelta(size_t fromRoute, size_t fromPosition, size_t toRoute, size_t toPosition) const noexcept
+    {
+        return segmentMoveDelta(fromRoute, fromPosition, fromPosition + 1, toRoute, toPosition, false);
+    }
+    
+    size_t relocationExcessLoad(size_t fromRoute, size_t fromPosition, size_t toRoute) const noexcept
+    {
+        return loads_.getExcessLoadAfterMove(fromRoute, toRoute, demandOf(getCustomer(fromRoute, fromPosition)));
+    }
+    
+    void relocate(size_t fromRoute, size_t fromPosition, size_t toRoute, size_t toPosition) noexcept
+    {
+        moveSegment(fromRoute, fromPosition, fromPosition + 1, toRoute, toPosition, false);
+    }
+    
+    // Distance variation of CompactRoutes::moveSegment, with the same conventions, the segment being reversed
+    // once inserted if 'reversed' is set. The segment itself keeps its length, as costs are symmetric.
+    double segmentMoveDelta(size_t fromRoute, size_t begin, size_t end, size_t toRoute, size_t toPosition, bool reversed) const noexcept
+    {
+        IdType first = getCustomer(fromRoute, begin);
+        IdType last = getCustomer(fromRoute, end - 1);
+        IdType before = predecessorOf(fromRoute, begin);
+        IdType after = successorOf(fromRoute, end - 1);
+        
+        double delta = costOf(before, after) - costOf(before, first) - costOf(last, after);
+        
+        // Neighbours of the insertion point, in the destination route once the segment has been removed
+        size_t length = end - begin;
+        size_t shift = fromRoute == toRoute ? length : 0;
+        size_t toSize = getRouteSize(toRoute) - shift;
+        IdType previous = toPosition == 0 ? depot_ : getCustomer(toRoute, toPosition - 1 + (toPosition - 1 >= begin ? shift : 0));
+        IdType next = toPosition >= toSize ? depot_ : getCustomer(toRoute, toPosition + (toPosition >= begin ? shift : 0));
+        
+        if(reversed)
+        {
+            std::swap(first, last);
+        }
+        
+        return delta + costOf(previous, first) + costOf(last, next) - costOf(previous, next);
+    }
+    
+    size_t segmentMoveExcessLoad(size_t fromRoute, size_t begin, size_t end, size_t toRoute) const noexcept
+    {
+        return loads_.getExcessLoadAfterMove(fromRoute, toRoute, getPrefixLoad(fromRoute, end) - getPrefixLoad(fromRoute, begin));
+    }
+    
+    void moveSegment(size_t fromRoute, size_t begin, size_t end, size_t toRoute, size_t toPosition, bool reversed) noexcept
+    {
+        size_t load = getPrefixLoad(fromRoute, end) - getPrefixLoad(fromRoute, begin);
+        
+        activate(predecessorOf(fromRoute, begin));
+        activate(successorOf(fromRoute, end - 1));
+        
+        distance_ += segmentMoveDelta(fromRoute, begin, end, toRoute, toPosition, reversed);
+        loads_.removeDemand(fromRoute, load);
+        loads_.addDemand(toRoute, load);
+        routes_.moveSegment(fromRoute, begin, end, toRoute, toPosition);
+        
+        if(reversed)
+        {
+            routes_.reverse(toRoute, toPosition, toPosition + end - begin);
+        }
+        
+        refreshRoutes(std::min(fromRoute, toRoute), std::max(fromRoute, toRoute));
+        refreshGeometry(fromRoute);
+        refreshGeometry(toRoute);
+        activateSegmentEnds(toRoute, toPosition, toPosition + end - begin);
+    }
+    
+    // Takes the customer out of its route, for a destroy and repair heuristic
+    void unassign(size_t route, size_t position) noexcept
+    {
+        IdType customer = getCustomer(route, position);
+        
+        activate(predecessorOf(route, position));
+        activate(successorOf(route, position));
+        
+        distance_ += removalDelta(route, position);
+        loads_.removeDemand(route, demandOf(customer));
+        routes_.unassign(route, position);
+        refreshRoutes(route, getNumberOfRoutes() - 1);
+        refreshGeometry(route);
+        routeOf_[customer] = unassignedRoute;
+        positionOf_[customer] = 0;
+    }
+    
+    // Inserts an unassigned customer at 'position' in the route
+    void assign(IdType customer, size_t route, size_t position) noexcept
+    {
+        const IdType* unassigned = routes_.unassignedBegin();
+        size_t index = std::find(unassigned, routes_.unassignedEnd(), customer) - unassigned;
+        
+        distance_ += insertionDelta(route, position, customer);
+        loads_.addDemand(route, demandOf(customer));
+        routes_.assign(index, route, position);
+        refreshRoutes(route, getNumberOfRoutes() - 1);
+        refreshGeometry(route);
+        activateSegmentEnds(route, position, position + 1);
+    }
+    
+    // Distance variation of CompactRoutes::reverse : only the two edges at the ends of the segment change
+    double reversalDelta(size_t route, size_t begin, size_t end) const noexcept
+    {
+        IdType first = getCustomer(route, begin);
+        IdType last = getCustomer(route, end - 1);
+        IdType before = predecessorOf(route, begin);
+        IdType after = successorOf(route, end - 1);
+        
+        return costOf(before, last) + costOf(first, after) - costOf(before, first) - costOf(last, after);
+    }
+    
+    void reverse(size_t route, size_t begin, size_t end) noexcept
+    {
+        distance_ += reversalDelta(route, begin, end);
+        routes_.reverse(route, begin, end);
+        refreshRoutes(route, route);
+        activateSegmentEnds(route, begin, end);
+    }
+    
+    // Distance variation of removing the customer at the given position
+    double removalDelta(size_t route, size_t position) const noexcept
+    {
+        IdType customer = getCustomer(route, position);
+        IdType before = predecessorOf(route, position);
+        IdType after = successorOf(route, position);
+        
+        return costOf(before, after) - costOf(before, customer) - costOf(customer, after);
+    }
+    
+    // Distance variation of inserting a customer at 'position' in the route
+    double insertionDelta(size_t route, size_t position, IdType customer) const noexcept
+    {
+        IdType previous = predecessorOf(route, position);
+        IdType next = position >= getRouteSize(route) ? depot_ : getCustomer(route, position);
+        
+        return costOf(previous, customer) + costOf(customer, next) - costOf(previous, next);
+    }
+    
+    // Distance variation of inserting a customer at 'position' in the route deprived of the customer at 'skippedPosition'
+    double insertionDelta(size_t route, size_t skippedPosition, size_t position, IdType customer) const noexcept
+    {
+        size_t reducedSize = getRouteSize(route) - 1;
+        IdType previous = position == 0 ? depot_ : getCustomer(route, position - 1 + (position - 1 >= skippedPosition ? 1 : 0));
+        IdType next = position >= reducedSize ? depot_ : getCustomer(route, position + (position >= skippedPosition ? 1 : 0));
+        
+        return costOf(previous, customer) + costOf(customer, next) - costOf(previous, next);
+    }
+    
+    // Exchange of two customers of distinct routes, each one being inserted anywhere in the other route.
+    // 'insertion1' is the position of the customer of 'route2' in 'route1' deprived of its own customer, and conversely.
+    double exchangeDelta(size_t route1, size_t position1, size_t insertion1, size_t route2, size_t position2, size_t insertion2) const noexcept
+    {
+        return removalDelta(route1, position1) + removalDelta(route2, position2)
+             + insertionDelta(route1, position1, insertion1, getCustomer(route2, position2))
+             + insertionDelta(route2, position2, insertion2, getCustomer(route1, position1));
+    }
+    
+    size_t exchangeExcessLoad(size_t route1, size_t position1, size_t route2, size_t position2) const noexcept
+    {
+        size_t demand1 = demandOf(getCustomer(route1, position1));
+        size_t demand2 = demandOf(getCustomer(route2, position2));
+        
+        return loads_.getExcessLoadAfterChange(route1, getRouteLoad(route1) - demand1 + demand2, route2, getRouteLoad(route2) - demand2 + demand1);
+    }
+    
+    // Performed as two relocations : the first customer is inserted in 'route2' where it ends at 'insertion2' once
+    // the second customer is gone, which then moves to 'route1'
+    void exchange(size_t route1, size_t position1, size_t insertion1, size_t route2, size_t position2, size_t insertion2) noexcept
+    {
+        bool before = insertion2 <= position2;
+        
+        relocate(route1, position1, route2, before ? insertion2 : insertion2 + 1);
+        relocate(route2, before ? position2 + 1 : position2, route1, insertion1);
+    }
+    
+    // Distance variation of CompactRoutes::swapSegments, with the same conventions
+    double segmentSwapDelta(size_t route1, size_t begin1, size_t end1, size_t route2, size_t begin2, size_t end2) const noexcept
+    {
+        IdType before1 = begin1 == 0 ? depot_ : getCustomer(route1, begin1 - 1);
+        IdType after1 = end1 == getRouteSize(route1) ? depot_ : getCustomer(route1, end1);
+        IdType before2 = begin2 == 0 ? depot_ : getCustomer(route2, begin2 - 1);
+        IdType after2 = end2 == getRouteSize(route2) ? depot_ : getCustomer(route2, end2);
+        
+        return linkCost(before1, route2, begin2, end2, after1) + linkCost(before2, route1, begin1, end1, after2)
+             - linkCost(before1, route1, begin1, end1, after1) - linkCost(before2, route2, begin2, end2, after2);
+    }
+    
+    size_t segmentSwapExcessLoad(size_t route1, size_t begin1, size_t end1, size_t route2, size_t begin2, size_t end2) const noexcept
+    {
+        size_t load1 = getPrefixLoad(route1, end1) - getPrefixLoad(route1, begin1);
+        size_t load2 = getPrefixLoad(route2, end2) - getPrefixLoad(route2, begin2);
+        
+        return loads_.getExcessLoadAfterChange(route1, getRouteLoad(route1) - load1 + load2, route2, getRouteLoad(route2) - load2 + load1);
+    }
+    
+    void swapSegments(size_t route1, size_t begin1, size_t end1, size_t route2, size_t begin2, size_t end2) noexcept
+    {
+        size_t load1 = getPrefixLoad(route1, end1) - getPrefixLoad(route1, begin1);
+        size_t load2 = getPrefixLoad(route2, end2) - getPrefixLoad(route2, begin2);
+        
+        distance_ += segmentSwapDelta(route1, begin1, end1, route2, begin2, end2);
+        loads_.removeDemand(route1, load1);
+        loads_.addDemand(route1, load2);
+        loads_.removeDemand(route2, load2);
+        loads_.addDemand(route2, load1);
+        routes_.swapSegments(route1, begin1, end1, route2, begin2, end2);
+        refreshRoutes(std::min(route1, route2), std::max(route1, route2));
+        refreshGeometry(route1);
+        refreshGeometry(route2);
+        activateSegmentEnds(route1, begin1, begin1 + end2 - begin2);
+        activateSegmentEnds(route2, begin2, begin2 + end1 - begin1);
+    }
+    
+    CVRPSolutionData toSolutionData() const
+    {
+        return routes_.toSolutionData(*instance_);
+    }
+    
+    private:
+    void activate(IdType customer) noexcept
+    {
+        if(activeCustomers_ != nullptr && customer != depot_)
+        {
+            activeCustomers_->activate(customer);
+        }
+    }
+    
+    // Activates the customers at both ends of the segment [begin, end) of the route, and around it, the segment being possibly empty
+    void activateSegmentEnds(size_t route, size_t begin, size_t end) noexcept
+    {
+        if(activeCustomers_ == nullptr)
+        {
+            return;
+        }
+        
+        for(size_t position : {begin - 1, begin, end - 1, end})
+        {
+            if(position < getRouteSize(route))
+            {
+                activate(getCustomer(route, position));
+            }
+        }
+    }
+    
+    // Cost of the path going from 'before' to 'after' through the segment [begin, end) of the route
+    double linkCost(IdType before, size_t route, size_t begin, size_t end, IdType after) const noexcept
+    {
+        if(begin == end)
+        {
+            return costOf(before, after);
+        }
+        
+        return costOf(before, getCustomer(route, begin)) + getPrefixDistance(route, end) - getPrefixDistance(route, begin + 1) + costOf(getCustomer(route, end - 1), after);
+    }
+    
+    // Recomputes the sector and the box of a route whose customers changed, the order of the customers being irrelevant
+    void refreshGeometry(size_t route) noexcept
+    {
+        routeSectors_[route].clear();
+        routeBoxes_[route].clear();
+        
+        for(const IdType* customer = routes_.routeBegin(route); customer != routes_.routeEnd(route); ++customer)
+        {
+            routeSectors_[route].extend(polarAngles_[*customer]);
+            routeBoxes_[route].extend(coordinates_[*customer]);
+        }
+    }
+    
+    // Recomputes the prefix data of the routes in [firstRoute, lastRoute], which covers every customer moved
+    // in the buffer by the primitives
+    void refreshRoutes(size_t firstRoute, size_t lastRoute) noexcept
+    {
+        for(size_t route = firstRoute; route <= lastRoute; ++route)
+        {
+            size_t offset = routes_.getRouteOffset(route);
+            size_t load = 0;
+            double distance = 0.0;
+            IdType previous = depot_;
+            
+            for(size_t position = 0; position < getRouteSize(route); ++position)
+            {
+                IdType customer = routes_.getCustomer(route, position);
+                load += demandOf(customer);
+                distance += costOf(previous, customer);
+                prefixLoads_[offset + position] = load;
+                prefixDistances_[offset + position] = distance;
+                routeOf_[customer] = static_cast<IdType>(route);
+                positionOf_[customer] = static_cast<IdType>(position);
+                previous = customer;
+            }
+        }
+    }
+    
+    const CVRPInstance* instance_;
+    CompactRoutes routes_;
+    CVRPRouteLoads loads_;
+    const double* costMatrix_;
+    size_t numberOfNodes_;
+    IdType depot_;
+    double distance_;
+    std::vector<size_t> prefixLoads_;
+    std::vector<double> prefixDistances_;
+    std::vector<Coordinates> coordinates_;
+    std::vector<PolarSector::AngleType> polarAngles_;
+    std::vector<PolarSector> routeSectors_;
+    std::vector<BoundingBox> routeBoxes_;
+    bool routePruning_;
+    std::vector<IdType> routeOf_;
+    std::vector<IdType> positionOf_;
+    const CandidateLists* candidateLists_;
+    ActiveCustomerQueue* activeCustomers_;
+};
+
+}
+
+#endif // SEARCH_SOLUTION_HXX
@@ -0,0 +1,167 @@
+#ifndef SIMULATED_ANNEALING_ACCEPTANCE_HXX
+#define SIMULATED_ANNEALING_ACCEPTANCE_HXX
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <GenericAcceptancePolicy.hxx>
+
+namespace Heuristic
+{
+
+enum class CoolingSchedule
+{
+    Geometric, // Cools along the run, up to whichever of its step count and time budget ends it first
+    TimeBased  // Cools along the time budget only
+};
+
+// Simulated annealing : a neighbour worsening the cost by delta is accepted with probability exp(-delta / T).
+// The temperature decreases geometrically from the initial to the final temperature,
+//     T = T0 * (Tf / T0)^progress
+// the progress being the fraction of the run, or of its time budget only, already elapsed.
+// A null initial temperature is calibrated at the beginning of each run : the first 'calibrationSamples' worsening
+// distance deltas observed are averaged, worsening neighbours being rejected meanwhile, and T0 is set so that the
+// average worsening would be accepted with probability 'initialAcceptance'. A null final temperature is then
+// 'finalTemperatureRatio' times T0.
+class SimulatedAnnealingAcceptance : public GenericAcceptancePolicy<SimulatedAnnealingAcceptance>
+{
+    public:
+    static constexpr double calibratedTemperature = 0.0;
+    static constexpr size_t defaultCalibrationSamples = 1000;
+    static constexpr double defaultInitialAcceptance = 0.5;
+    static constexpr double defaultFinalTemperatureRatio = 1e-3;
+    
+    public:
+    explicit SimulatedAnnealingAcceptance(double initialTemperature = calibratedTemperature,
+                                          double finalTemperature = calibratedTemperature,
+                                          CoolingSchedule schedule = CoolingSchedule::Geometric)
+    : initialTemperature_{initialTemperature},
+      finalTemperature_{finalTemperature},
+      schedule_{schedule},
+      calibrationSamples_{defaultCalibrationSamples},
+      initialAcceptance_{defaultInitialAcceptance},
+      finalTemperatureRatio_{defaultFinalTemperatureRatio},
+      startTemperature_{initialTemperature},
+      endTemperature_{finalTemperature},
+      temperature_{initialTemperature},
+      sampledDeltas_{0},
+      sumOfSampledDeltas_{0.0}
+    {}
+    
+    SimulatedAnnealingAcceptance(const SimulatedAnnealingAcceptance&) = default;
+    SimulatedAnnealingAcceptance(SimulatedAnnealingAcceptance&&) = default;
+    
+    SimulatedAnnealingAcceptance& operator=(const SimulatedAnnealingAcceptance&) = default;
+    SimulatedAnnealingAcceptance& operator=(SimulatedAnnealingAcceptance&&) = default;
+    
+    // Only used when the initial temperature is calibrated
+    void setCalibration(size_t calibrationSamples, double initialAcceptance, double finalTemperatureRatio) noexcept
+    {
+        calibrationSamples_ = calibrationSamples;
+        initialAcceptance_ = initialAcceptance;
+        finalTemperatureRatio_ = finalTemperatureRatio;
+    }
+    
+    CoolingSchedule getSchedule() const noexcept { return schedule_; }
+    double getTemperature() const noexcept { return temperature_; }
+    
+    // Temperatures of the last run, once calibrated
+    double getInitialTemperature() const noexcept { return startTemperature_; }
+    double getFinalTemperature() const noexcept { return endTemperature_; }
+    
+    bool isCalibrating() const noexcept
+    {
+        return startTemperature_ <= 0.0;
+    }
+    
+    void start(double) noexcept
+    {
+        sampledDeltas_ = 0;
+        sumOfSampledDeltas_ = 0.0;
+        
+        if(initialTemperature_ > 0.0)
+        {
+            setTemperatures(initialTemperature_);
+        }
+        else
+        {
+            startTemperature_ = calibratedTemperature;
+            endTemperature_ = calibratedTemperature;
+            temperature_ = calibratedTemperature;
+        }
+    }
+    
+    template<class RandomEngine>
+    bool accept(double currentCost, double newCost, RandomEngine& randomEngine)
+    {
+        double delta = newCost - currentCost;
+        
+        if(delta < 0.0)
+        {
+            return true;
+        }
+        
+        if(isCalibrating())
+        {
+            return false;
+        }
+        
+        return std::uniform_real_distribution<double>{0.0, 1.0}(randomEngine) < std::exp(-delta / temperature_);
+    }
+    
+    void observeDelta(double distanceDelta) noexcept
+    {
+        // Neutral neighbours tell nothing about the scale of the distances
+        if(!isCalibrating() || distanceDelta <= 0.0)
+        {
+            return;
+        }
+        
+        sumOfSampledDeltas_ += distanceDelta;
+        ++sampledDeltas_;
+        
+        if(sampledDeltas_ == calibrationSamples_)
+        {
+            setTemperatures(-(sumOfSampledDeltas_ / sampledDeltas_) / std::log(initialAcceptance_));
+        }
+    }
+    
+    void update(const SearchProgress& progress) noexcept
+    {
+        if(isCalibrating())
+        {
+            return;
+        }
+        
+        double fraction = schedule_ == CoolingSchedule::Geometric ? progress.getFraction() : progress.timeFraction;
+        temperature_ = startTemperature_ * std::pow(endTemperature_ / startTemperature_, std::min(fraction, 1.0));
+    }
+    
+    private:
+    void setTemperatures(double initialTemperature) noexcept
+    {
+        startTemperature_ = initialTemperature;
+        endTemperature_ = finalTemperature_ > 0.0 ? finalTemperature_ : finalTemperatureRatio_ * initialTemperature;
+        temperature_ = startTemperature_;
+    }
+    
+    // Configuration, null temperatures being calibrated
+    double initialTemperature_;
+    double finalTemperature_;
+    CoolingSchedule schedule_;
+    size_t calibrationSamples_;
+    double initialAcceptance_;
+    double finalTemperatureRatio_;
+    
+    // State of the current run
+    double startTemperature_;
+    double endTemperature_;
+    double temperature_;
+    size_t sampledDeltas_;
+    double sumOfSampledDeltas_;
+};
+
+}
+
+#endif // SIMULATED_ANNEALING_ACCEPTANCE_HXX
@@ -1,6 +1,7 @@
 #ifndef SOLUTION_LOADER_HXX
 #define SOLUTION_LOADER_HXX
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -101,7 +102,8 @@ class SolutionLoader
             CVRPSolution::DataType routes;
             double solutionTime = -1.0;
             
-            CVRPInstance instance = *InstanceLoader().loadCVRPInstance(instanceFile);
+            // The solution shares the ownership of the instance, as nobody else keeps it alive
+            auto instance = std::make_shared<const CVRPInstance>(*InstanceLoader().loadCVRPInstance(instanceFile));
             
             while(end != std::string::npos)
             {
@@ -122,7 +124,7 @@ class SolutionLoader
                         std::string routeNode = routeStr.substr(currentIt, nextIt - currentIt);
                         Utils::rtrim(routeNode);
                         std::cout << routeNode << std::endl;
-                        routes.back().push_back(instance.getNode(std::stol(routeNode)));
+                        routes.back().push_back(instance->getNode(std::stol(routeNode)));
                         currentIt = nextIt + 1;
                         oldNext = nextIt;
                         nextIt = routeStr.find(' ', currentIt);
@@ -141,8 +143,8 @@ class SolutionLoader
                 end = data.find(delim, end + 1);
             }
             
-            std::cout << instance.getName() << std::endl;
-            return {CVRPSolution{instance, routes}};
+            std::cout << instance->getName() << std::endl;
+            return {CVRPSolution{std::move(instance), std::move(routes)}};
         }
         catch(const std::ifstream::failure& e)
         {
@@ -1,109 +1,329 @@
 #ifndef STOCHASTIC_DESCENT_CVRP_SOLVER_HXX
 #define STOCHASTIC_DESCENT_CVRP_SOLVER_HXX
 
-#include <random>
+#include <array>
+#include <ostream>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
+#include <AdaptiveOperatorSelector.hxx>
+#include <AnytimeSolverSettings.hxx>
+#include <BestSolutionRecorder.hxx>
+#include <CandidateLists.hxx>
+#include <CapacityPenaltyController.hxx>
 #include <CVRPInstance.hxx>
 #include <CVRPSolution.hxx>
 #include <GenericCVRPSolver.hxx>
+#include <ImprovementAcceptance.hxx>
+#include <NeighbourhoodSearchSettings.hxx>
+#include <NeighbourhoodStatistics.hxx>
+#include <RandomEngine.hxx>
+#include <SearchSolution.hxx>
+#include <TimeBudget.hxx>
 
 namespace Solver
 {
     
-template<class BaseSolver, class ... Neighbourhoods>
-class StochasticDescentCVRPSolver : public GenericCVRPSolver<StochasticDescentCVRPSolver<BaseSolver, Neighbourhoods...>>
+// Draws a neighbourhood and a move from it at each step, and moves to the neighbour if the acceptance policy accepts
+// it. With Heuristic::ImprovementAcceptance, the search is a descent, see StochasticDescentCVRPSolver below.
+template<class BaseSolver, class AcceptancePolicy, class ... Neighbourhoods>
+class StochasticLocalSearchCVRPSolver : public GenericCVRPSolver<StochasticLocalSearchCVRPSolver<BaseSolver, AcceptancePolicy, Neighbourhoods...>>,
+                                        public AnytimeSolverSettings,
+                                        public NeighbourhoodSearchSettings
 {
     private:
     using NeighbourhoodTupleType = std::tuple<Neighbourhoods...>;
     using CVRPInstance = Data::CVRPInstance;
+    using StatisticsArrayType = std::array<Heuristic::NeighbourhoodStatistics, sizeof...(Neighbourhoods)>;
     
-    template<class T, size_t first, size_t ... next>
-    struct dynamic_get_impl
+    struct StepOutcome
     {
-        auto get(const T& container, size_t index)
-        {
-            if(first == index) return std::get<first>(container);
-            else return dynamic_get_impl<T, next...>{}.get(container, index);
-        }
+        bool accepted;
+        bool improving;
     };
     
-    template<class T, size_t last>
-    struct dynamic_get_impl<T, last>
+    static constexpr const char* neighbourhoodNames[] = {Neighbourhoods::name...};
+    
+    // Calls the visitor on the element of the tuple at the given runtime index, by reference.
+    // The index selects an entry of a table of function pointers, one per element, so that the dispatch compiles to
+    // a single indirect call instead of a chain of comparisons.
+    template<size_t index, class T, class Visitor>
+    static void visit_at(T& container, Visitor& visitor)
     {
-        auto get(const T& container, size_t)
-        {
-            return std::get<last>(container);
-        }
-    };
+        visitor(std::get<index>(container));
+    }
     
-    template<class T, size_t ... indices>
-    static auto dynamic_get_aux(const T& container, size_t index, std::index_sequence<indices...>)
+    template<class T, class Visitor, size_t ... indices>
+    static void dynamic_visit_aux(T& container, size_t index, Visitor& visitor, std::index_sequence<indices...>)
     {
-        return dynamic_get_impl<T, indices...>{}.get(container, index);
+        using VisitFunctionType = void (*)(T&, Visitor&);
+        static constexpr VisitFunctionType table[] = {&visit_at<indices, T, Visitor>...};
+        table[index](container, visitor);
     }
     
-    template<class T>
-    static auto dynamic_get(const T& container, size_t index)
+    template<class T, class Visitor>
+    static void dynamic_visit(T& container, size_t index, Visitor&& visitor)
     {
-        return dynamic_get_aux(container, index, std::make_index_sequence<std::tuple_size<T>::value>());
+        dynamic_visit_aux(container, index, visitor, std::make_index_sequence<std::tuple_size<T>::value>());
     }
     
     public:
-    StochasticDescentCVRPSolver(const BaseSolver& baseSolver, size_t steps) 
-    : GenericCVRPSolver<StochasticDescentCVRPSolver>(),
+    static constexpr size_t unlimitedSteps = unlimitedIterations;
+    
+    // Number of steps between two updates of the progress of the run given to the acceptance policy
+    static constexpr size_t progressUpdatePeriod = 256;
+    
+    // The capacity repair gives up after this number of steps in a row without improvement
+    static constexpr size_t maxRepairStallSteps = 100000;
+    
+    public:
+    StochasticLocalSearchCVRPSolver(const BaseSolver& baseSolver, 
+                                    size_t steps, 
+                                    double wrongCapacityPenalty = CVRPSolutionCostProcessor::defaultWrongCapacityPenalty,
+                                    double repairCapacityPenalty = defaultRepairCapacityPenalty,
+                                    const AcceptancePolicy& acceptancePolicy = AcceptancePolicy{}) 
+    : StochasticLocalSearchCVRPSolver(baseSolver, steps, CapacityPenaltyController{wrongCapacityPenalty}, repairCapacityPenalty, acceptancePolicy)
+    {}
+    
+    StochasticLocalSearchCVRPSolver(const BaseSolver& baseSolver, 
+                                    size_t steps, 
+                                    const CapacityPenaltyController& penaltyController,
+                                    double repairCapacityPenalty = defaultRepairCapacityPenalty,
+                                    const AcceptancePolicy& acceptancePolicy = AcceptancePolicy{}) 
+    : GenericCVRPSolver<StochasticLocalSearchCVRPSolver>(),
+      AnytimeSolverSettings(),
+      NeighbourhoodSearchSettings(repairCapacityPenalty),
       baseSolver_{baseSolver},
       steps_{steps},
-      neighbourhoods_{}
+      penaltyController_{penaltyController},
+      acceptancePolicy_{acceptancePolicy},
+      reactionFactor_{0.0},
+      segmentLength_{Heuristic::AdaptiveOperatorSelector::defaultSegmentLength},
+      neighbourhoods_{},
+      statistics_{},
+      operatorSelector_{sizeof...(Neighbourhoods)}
     {}
     
-    CVRPSolution solve(const CVRPInstance& instance)
+    void setAcceptancePolicy(const AcceptancePolicy& acceptancePolicy)
+    {
+        acceptancePolicy_ = acceptancePolicy;
+    }
+    
+    // Policy of the last run, holding its final state
+    const AcceptancePolicy& getAcceptancePolicy() const noexcept
+    {
+        return acceptancePolicy_;
+    }
+    
+    // With a non zero reaction factor, the neighbourhoods are drawn with weights following the rate of improving
+    // moves they produced over the last segments of 'segmentLength' steps, instead of uniformly
+    void setOperatorAdaptation(double reactionFactor, size_t segmentLength = Heuristic::AdaptiveOperatorSelector::defaultSegmentLength) noexcept
+    {
+        reactionFactor_ = reactionFactor;
+        segmentLength_ = segmentLength;
+    }
+    
+    double getReactionFactor() const noexcept
+    {
+        return reactionFactor_;
+    }
+    
+    size_t getSegmentLength() const noexcept
+    {
+        return segmentLength_;
+    }
+    
+    // Selector of the last run, holding the final weights of the neighbourhoods
+    const Heuristic::AdaptiveOperatorSelector& getOperatorSelector() const noexcept
     {
-        constexpr auto numberOfNeighbourhoods = std::tuple_size<NeighbourhoodTupleType>::value;
+        return operatorSelector_;
+    }
+    
+    // Counters of each neighbourhood over the last run, in the order of the template parameters
+    const StatisticsArrayType& getStatistics() const noexcept
+    {
+        return statistics_;
+    }
+    
+    const Heuristic::NeighbourhoodStatistics& getStatistics(size_t neighbourhoodIdx) const noexcept
+    {
+        return statistics_[neighbourhoodIdx];
+    }
+    
+    // One line per neighbourhood and a total. Runs print nothing themselves : the caller dumps the counters of the
+    // last run wherever it wants.
+    void printStatistics(std::ostream& os) const
+    {
+        Heuristic::NeighbourhoodStatistics total;
+        
+        for(size_t i = 0; i < statistics_.size(); ++i)
+        {
+            statistics_[i].print(os, neighbourhoodNames[i]);
+            total += statistics_[i];
+        }
         
-        std::random_device en;
-        std::mt19937 randomEngine(en());
-        std::uniform_int_distribution<unsigned int> distrib(0, numberOfNeighbourhoods - 1);
+        total.print(os, "total");
+    }
+    
+    CVRPSolution solve(const CVRPInstance& instance)
+    {
+        Heuristic::RandomEngine randomEngine = startRandomEngine();
         
         auto origSol = baseSolver_.solve(instance);
-        CVRPSolution::CostProcessor costProcessor;
-        auto bestSolData = origSol.getData();
-        std::cout << costProcessor.computeCost(instance, bestSolData) << std::endl;
+        auto penaltyController = penaltyController_;
+        CVRPSolution::CostProcessor costProcessor{penaltyController.getPenalty()};
+        Heuristic::SearchSolution solution{instance, origSol.getData()};
+        
+        Heuristic::CandidateLists candidateLists = createCandidateLists(instance);
+        configure(solution, candidateLists);
+        
+        statistics_ = StatisticsArrayType{};
+        operatorSelector_ = Heuristic::AdaptiveOperatorSelector{sizeof...(Neighbourhoods), reactionFactor_, segmentLength_};
+        
+        // The capacity repair at the end of the run is bounded by the time budget as well
+        TimeBudget timeBudget = startTimeBudget();
+        BestSolutionRecorder best{instance, getBestSolutionCallback()};
+        best.record(solution);
+        
+        size_t performedSteps = 0;
+        acceptancePolicy_.start(solution.getCost(costProcessor));
         
-        for(size_t i = 0; i < steps_; ++i)
+        for(; performedSteps < steps_ && !timeBudget.isExhausted(); ++performedSteps)
         {
-            if(i%10000 == 0)
-            {std::cout << i << std::endl;}
-            auto newSolData = dynamic_get(neighbourhoods_, distrib(randomEngine)).randomNeighbour(bestSolData);
-            if(costProcessor.computeCost(instance, newSolData) < costProcessor.computeCost(instance, bestSolData))
+            if(performedSteps%progressUpdatePeriod == 0)
             {
-                bestSolData = newSolData;
+                acceptancePolicy_.update(progressOf(performedSteps, steps_, timeBudget));
             }
+            
+            size_t neighbourhoodIdx = operatorSelector_.select(randomEngine);
+            StepOutcome outcome = step(solution, costProcessor, penaltyController, acceptancePolicy_, randomEngine, neighbourhoodIdx);
+            
+            if(outcome.improving)
+            {
+                operatorSelector_.reward(neighbourhoodIdx, 1.0);
+            }
+            
+            if(outcome.accepted)
+            {
+                best.record(solution);
+            }
+            
+            acceptancePolicy_.endStep(solution.getCost(costProcessor));
         }
         
-        std::cout << "Done" << std::endl;
-        CVRPSolutionCostProcessor<1000000> finalCostProcessor;
-        std::cout << finalCostProcessor.satisfiesConstraints(instance, bestSolData) << std::endl;
-        while(!finalCostProcessor.satisfiesConstraints(instance, bestSolData))
+        // The route count never changes, so only the capacity can still be violated at this point.
+        // The repair is a descent whatever the acceptance policy, the penalty dominating the cost.
+        CapacityPenaltyController repairPenaltyController = getRepairPenaltyController();
+        Heuristic::ImprovementAcceptance repairAcceptance;
+        repairPenaltyController.applyTo(costProcessor);
+        for(size_t stallSteps = 0; !solution.isFeasible() && stallSteps < maxRepairStallSteps && !timeBudget.isExhausted(); ++stallSteps)
         {
-            auto newSolData = dynamic_get(neighbourhoods_, distrib(randomEngine)).randomNeighbour(bestSolData);
-            if(costProcessor.computeCost(instance, newSolData) < costProcessor.computeCost(instance, bestSolData))
+            size_t neighbourhoodIdx = operatorSelector_.select(randomEngine);
+            if(step(solution, costProcessor, repairPenaltyController, repairAcceptance, randomEngine, neighbourhoodIdx).improving)
             {
-                bestSolData = newSolData;
-                std::cout << "FOUND ! " << std::endl;
+                operatorSelector_.reward(neighbourhoodIdx, 1.0);
+                stallSteps = 0;
             }
         }
         
-        return {instance, bestSolData};
+        best.record(solution);
+        
+        // Without any feasible solution found within the budget, the current one is the best available
+        if(!best.hasSolution())
+        {
+            return {instance, solution.toSolutionData()};
+        }
+        
+        return best.toSolution();
     }
     
     private:
+    // Draws a move from the given neighbourhood, and applies it in place if the acceptance policy accepts it.
+    // Only one step out of NeighbourhoodStatistics::timingPeriod reads the clock.
+    template<class Acceptance, class RandomEngine>
+    StepOutcome step(Heuristic::SearchSolution& solution,
+                     CVRPSolutionCostProcessor& costProcessor,
+                     CapacityPenaltyController& penaltyController,
+                     Acceptance& acceptance,
+                     RandomEngine& randomEngine,
+                     size_t neighbourhoodIdx)
+    {
+        Heuristic::NeighbourhoodStatistics& statistics = statistics_[neighbourhoodIdx];
+        bool timed = statistics.shouldTime();
+        auto start = timed ? Heuristic::NeighbourhoodStatistics::ClockType::now() : Heuristic::NeighbourhoodStatistics::ClockType::time_point{};
+        StepOutcome outcome{false, false};
+        
+        ++statistics.proposed;
+        
+        dynamic_visit(neighbourhoods_, neighbourhoodIdx, [&](auto& neighbourhood)
+        {
+            typename std::decay_t<decltype(neighbourhood)>::Move move;
+            
+            if(!neighbourhood.randomMove(solution, randomEngine, move))
+            {
+                return;
+            }
+            
+            ++statistics.evaluated;
+            auto evaluation = neighbourhood.evaluate(solution, move);
+            
+            if(penaltyController.recordMove(evaluation.excessLoad == 0))
+            {
+                penaltyController.applyTo(costProcessor);
+            }
+            
+            double currentCost = solution.getCost(costProcessor);
+            double newCost = costProcessor.computeCost(solution.getDistance() + evaluation.distanceDelta, evaluation.excessLoad);
+            
+            if(evaluation.excessLoad == solution.getExcessLoad())
+            {
+                acceptance.observeDelta(evaluation.distanceDelta);
+            }
+            
+            outcome.improving = newCost < currentCost;
+            outcome.accepted = acceptance.accept(currentCost, newCost, randomEngine);
+            
+            if(outcome.improving)
+            {
+                ++statistics.improving;
+            }
+            
+            if(outcome.accepted)
+            {
+                neighbourhood.apply(solution, move);
+                ++statistics.accepted;
+                
+                if(outcome.improving)
+                {
+                    statistics.totalGain += currentCost - newCost;
+                }
+            }
+        });
+        
+        if(timed)
+        {
+            statistics.addTimeSample(Heuristic::NeighbourhoodStatistics::ClockType::now() - start);
+        }
+        
+        return outcome;
+    }
+    
     BaseSolver baseSolver_;
     size_t steps_;
-    const NeighbourhoodTupleType neighbourhoods_;
+    CapacityPenaltyController penaltyController_;
+    AcceptancePolicy acceptancePolicy_;
+    double reactionFactor_;
+    size_t segmentLength_;
+    NeighbourhoodTupleType neighbourhoods_;
+    StatisticsArrayType statistics_;
+    Heuristic::AdaptiveOperatorSelector operatorSelector_;
 };
 
+// Stochastic descent : only the neighbours strictly improving the cost are accepted
+template<class BaseSolver, class ... Neighbourhoods>
+using StochasticDescentCVRPSolver = StochasticLocalSearchCVRPSolver<BaseSolver, Heuristic::ImprovementAcceptance, Neighbourhoods...>;
+
 }
 
 #endif // STOCHASTIC_DESCENT_CVRP_SOLVER_HXX
\ No newline at end of file
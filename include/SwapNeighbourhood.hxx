@@ -0,0 +1,119 @@
+#ifndef SWAP_NEIGHBOURHOOD_HXX
+#define SWAP_NEIGHBOURHOOD_HXX
+
+#include <random>
+
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// Inter-route swap (1-1) : two customers of distinct routes exchange their places.
+// Unlike a relocation, the load of both routes changes by the difference of the two demands only,
+// which keeps it useful when every route is close to its capacity.
+class SwapNeighbourhood : public GenericNeighbourhoodGenerator<SwapNeighbourhood>
+{
+    public:
+    struct Move
+    {
+        size_t route1;
+        size_t position1;
+        size_t route2;
+        size_t position2;
+    };
+    
+    // The customer takes the place of the predecessor or of the successor of its candidate
+    static constexpr size_t granularVariants = 2;
+    
+    static constexpr const char* name = "swap";
+    
+    public:
+    using GenericNeighbourhoodGenerator::GenericNeighbourhoodGenerator;
+    
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        if(solution.isGranular())
+        {
+            return randomGranularMove(solution, randomEngine, move);
+        }
+        
+        if(!pickTwoRoutes(solution, randomEngine, move.route1, move.route2)
+        || solution.canSkipRoutePair(move.route1, move.route2)
+        || solution.getRouteSize(move.route1) == 0
+        || solution.getRouteSize(move.route2) == 0)
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> positionPicker1(0, solution.getRouteSize(move.route1) - 1);
+        std::uniform_int_distribution<size_t> positionPicker2(0, solution.getRouteSize(move.route2) - 1);
+        move.position1 = positionPicker1(randomEngine);
+        move.position2 = positionPicker2(randomEngine);
+        
+        return true;
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        return {solution.segmentSwapDelta(move.route1, move.position1, move.position1 + 1, move.route2, move.position2, move.position2 + 1),
+                solution.segmentSwapExcessLoad(move.route1, move.position1, move.position1 + 1, move.route2, move.position2, move.position2 + 1)};
+    }
+    
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.swapSegments(move.route1, move.position1, move.position1 + 1, move.route2, move.position2, move.position2 + 1);
+    }
+    
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        apply(solution, move);
+    }
+    
+    // Every customer of every other route
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor&& visitor) const
+    {
+        if(solution.isGranular())
+        {
+            return forEachGranularMove(solution, customer, visitor);
+        }
+        
+        Move move;
+        move.route1 = solution.routeOf(customer);
+        move.position1 = solution.positionOf(customer);
+        
+        for(move.route2 = 0; move.route2 < solution.getNumberOfRoutes(); ++move.route2)
+        {
+            if(move.route2 == move.route1 || solution.canSkipRoutePair(move.route1, move.route2))
+            {
+                continue;
+            }
+            
+            for(move.position2 = 0; move.position2 < solution.getRouteSize(move.route2); ++move.position2)
+            {
+                if(visitor(move))
+                {
+                    return true;
+                }
+            }
+        }
+        
+        return false;
+    }
+    
+    bool granularMove(const SearchSolution& solution, SearchSolution::IdType customer, SearchSolution::IdType candidate, size_t variant, Move& move) const noexcept
+    {
+        move.route1 = solution.routeOf(customer);
+        move.position1 = solution.positionOf(customer);
+        move.route2 = solution.routeOf(candidate);
+        move.position2 = solution.positionOf(candidate) + 2 * variant - 1; // Wraps around when the candidate comes first, and is rejected below
+        
+        return move.route1 != move.route2 && move.position2 < solution.getRouteSize(move.route2);
+    }
+};
+
+}
+
+#endif // SWAP_NEIGHBOURHOOD_HXX
@@ -0,0 +1,257 @@
+#ifndef SWAP_STAR_NEIGHBOURHOOD_HXX
+#define SWAP_STAR_NEIGHBOURHOOD_HXX
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <InsertionEvaluator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// SWAP* (Vidal, 2022) : two customers of distinct routes are exchanged, each one being reinserted at its best position
+// in the other route rather than in place of the other customer.
+// Drawing a move picks two routes whose polar sectors and bounding boxes overlap, and looks for the best exchange between them. The three
+// best insertion positions of every customer in the other route are computed once for the pair, so that the best
+// insertion in the other route deprived of one of its customers is found in constant time : it is either in place of
+// that customer, or one of the three cached positions which are not adjacent to it.
+class SwapStarNeighbourhood : public GenericNeighbourhoodGenerator<SwapStarNeighbourhood>
+{
+    public:
+    // 'insertion1' is the position of the customer of 'route2' in 'route1' deprived of its own customer, and conversely
+    struct Move
+    {
+        size_t route1;
+        size_t position1;
+        size_t insertion1;
+        size_t route2;
+        size_t position2;
+        size_t insertion2;
+    };
+    
+    static constexpr const char* name = "swap*";
+    
+    public:
+    using GenericNeighbourhoodGenerator::GenericNeighbourhoodGenerator;
+    
+    // Only exchanges which do not increase the excess load are considered, as the distance is the only thing
+    // this operator optimizes. Returns false if the routes do not overlap, or if there is no such exchange.
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        size_t route1;
+        size_t route2;
+        
+        if(!pickRoutes(solution, randomEngine, route1, route2)
+        || !solution.routesOverlap(route1, route2))
+        {
+            return false;
+        }
+        
+        computeBestInsertions(solution, route1, route2, bestInsertions1_);
+        computeBestInsertions(solution, route2, route1, bestInsertions2_);
+        
+        size_t size1 = solution.getRouteSize(route1);
+        size_t size2 = solution.getRouteSize(route2);
+        double bestDelta = std::numeric_limits<double>::infinity();
+        
+        for(size_t position1 = 0; position1 < size1; ++position1)
+        {
+            double removal1 = solution.removalDelta(route1, position1);
+            
+            for(size_t position2 = 0; position2 < size2; ++position2)
+            {
+                if(solution.exchangeExcessLoad(route1, position1, route2, position2) > solution.getExcessLoad())
+                {
+                    continue;
+                }
+                
+                size_t insertion1;
+                size_t insertion2;
+                double delta = removal1 + solution.removalDelta(route2, position2)
+                             + bestInsertion(solution, route1, position1, bestInsertions2_[position2], solution.getCustomer(route2, position2), insertion1)
+                             + bestInsertion(solution, route2, position2, bestInsertions1_[position1], solution.getCustomer(route1, position1), insertion2);
+                
+                if(delta < bestDelta)
+                {
+                    bestDelta = delta;
+                    move = {route1, position1, insertion1, route2, position2, insertion2};
+                }
+            }
+        }
+        
+        return bestDelta != std::numeric_limits<double>::infinity();
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        return {solution.exchangeDelta(move.route1, move.position1, move.insertion1, move.route2, move.position2, move.insertion2),
+                solution.exchangeExcessLoad(move.route1, move.position1, move.route2, move.position2)};
+    }
+    
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.exchange(move.route1, move.position1, move.insertion1, move.route2, move.position2, move.insertion2);
+    }
+    
+    // Each customer now sits at its insertion position, and goes back to its original position in its route
+    // deprived of the other customer
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.exchange(move.route1, move.insertion1, move.position1, move.route2, move.insertion2, move.position2);
+    }
+    
+    // Exchanges of the customer with every customer of every other route overlapping its own, or of the routes of its
+    // candidates in granular mode, both being reinserted at their best positions
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor&& visitor) const
+    {
+        size_t route1 = solution.routeOf(customer);
+        
+        if(!solution.isGranular())
+        {
+            for(size_t route2 = 0; route2 < solution.getNumberOfRoutes(); ++route2)
+            {
+                if(route2 != route1 && solution.routesOverlap(route1, route2) && forEachMoveWith(solution, customer, route2, visitor))
+                {
+                    return true;
+                }
+            }
+            
+            return false;
+        }
+        
+        const CandidateLists& candidateLists = *solution.getCandidateLists();
+        for(auto candidate = candidateLists.candidatesBegin(customer); candidate != candidateLists.candidatesEnd(customer); ++candidate)
+        {
+            size_t route2 = solution.routeOf(*candidate);
+            
+            // Candidates sharing a route only yield the route once
+            bool visited = route2 == route1 || std::any_of(candidateLists.candidatesBegin(customer), candidate, [&](SearchSolution::IdType other)
+            {
+                return solution.routeOf(other) == route2;
+            });
+            
+            if(!visited && solution.routesOverlap(route1, route2) && forEachMoveWith(solution, customer, route2, visitor))
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    private:
+    template<class Visitor>
+    bool forEachMoveWith(const SearchSolution& solution, SearchSolution::IdType customer, size_t route2, Visitor& visitor) const
+    {
+        Move move;
+        move.route1 = solution.routeOf(customer);
+        move.position1 = solution.positionOf(customer);
+        move.route2 = route2;
+        
+        computeBestInsertions(solution, route2, move.route1, bestInsertions2_);
+        InsertionCandidates customerInsertions = computeBestInsertionsOf(solution, customer, route2);
+        
+        for(move.position2 = 0; move.position2 < solution.getRouteSize(route2); ++move.position2)
+        {
+            bestInsertion(solution, move.route1, move.position1, bestInsertions2_[move.position2], solution.getCustomer(route2, move.position2), move.insertion1);
+            bestInsertion(solution, route2, move.position2, customerInsertions, customer, move.insertion2);
+            
+            if(visitor(move))
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    // In granular mode, the routes are the ones of a customer and of one of its candidates
+    template<class RandomEngine>
+    static bool pickRoutes(const SearchSolution& solution, RandomEngine& randomEngine, size_t& route1, size_t& route2)
+    {
+        if(!solution.isGranular())
+        {
+            return pickTwoRoutes(solution, randomEngine, route1, route2);
+        }
+        
+        SearchSolution::IdType customer;
+        SearchSolution::IdType candidate;
+        
+        if(!pickCandidateEdge(solution, randomEngine, customer, candidate))
+        {
+            return false;
+        }
+        
+        route1 = solution.routeOf(customer);
+        route2 = solution.routeOf(candidate);
+        
+        return route1 != route2;
+    }
+    
+    // Three cheapest insertions of a customer, positions being expressed in the complete route, sorted by cost
+    struct InsertionCandidates
+    {
+        static constexpr size_t size = 3;
+        
+        double costs[size] = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+        size_t positions[size] = {0, 0, 0};
+    };
+    
+    InsertionCandidates computeBestInsertionsOf(const SearchSolution& solution, SearchSolution::IdType customer, size_t toRoute) const noexcept
+    {
+        InsertionCandidates bestInsertions;
+        
+        insertionEvaluator_.loadRoute(solution, toRoute);
+        insertionEvaluator_.bestInsertions(customer, InsertionCandidates::size, bestInsertions.positions, bestInsertions.costs);
+        
+        return bestInsertions;
+    }
+    
+    // Best insertions in 'toRoute' of every customer of 'fromRoute', 'toRoute' being loaded once for all of them
+    void computeBestInsertions(const SearchSolution& solution, size_t fromRoute, size_t toRoute, std::vector<InsertionCandidates>& bestInsertions) const
+    {
+        bestInsertions.assign(solution.getRouteSize(fromRoute), InsertionCandidates{});
+        insertionEvaluator_.loadRoute(solution, toRoute);
+        
+        for(size_t i = 0; i < bestInsertions.size(); ++i)
+        {
+            insertionEvaluator_.bestInsertions(solution.getCustomer(fromRoute, i), InsertionCandidates::size, bestInsertions[i].positions, bestInsertions[i].costs);
+        }
+    }
+    
+    // Best insertion of the customer in 'route' deprived of the customer at 'skippedPosition', the position returned
+    // being expressed in the deprived route
+    static double bestInsertion(const SearchSolution& solution, size_t route, size_t skippedPosition, const InsertionCandidates& candidates,
+                                SearchSolution::IdType customer, size_t& position) noexcept
+    {
+        position = skippedPosition;
+        double best = solution.insertionDelta(route, skippedPosition, skippedPosition, customer);
+        
+        for(size_t i = 0; i < InsertionCandidates::size; ++i)
+        {
+            size_t candidate = candidates.positions[i];
+            if(candidates.costs[i] < best && candidate != skippedPosition && candidate != skippedPosition + 1)
+            {
+                best = candidates.costs[i];
+                position = candidate < skippedPosition ? candidate : candidate - 1;
+                break;
+            }
+        }
+        
+        return best;
+    }
+    
+    // Scratch buffers, kept between draws to avoid reallocating them
+    mutable std::vector<InsertionCandidates> bestInsertions1_;
+    mutable std::vector<InsertionCandidates> bestInsertions2_;
+    mutable InsertionEvaluator insertionEvaluator_;
+};
+
+}
+
+#endif // SWAP_STAR_NEIGHBOURHOOD_HXX
@@ -0,0 +1,153 @@
+#ifndef TABU_LIST_HXX
+#define TABU_LIST_HXX
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Heuristic
+{
+
+// Tabu attributes, the edges between two nodes, each one with the iteration from which it is allowed again.
+// Attributes live in a flat open addressing table, probed linearly from a Fibonacci hash of the edge, so that checking
+// an edge costs a multiplication and, most of the time, a single cache line.
+// Expired attributes are not removed one by one : they keep their slot until the table is more than half full, at
+// which point it is rebuilt with the live attributes only, and grown if these alone fill more than a quarter of it.
+class TabuList
+{
+    public:
+    using IdType = uint32_t;
+    
+    static constexpr size_t defaultCapacity = 1024;
+    
+    public:
+    explicit TabuList(size_t capacity = defaultCapacity)
+    : slots_{},
+      shift_{0},
+      occupiedSlots_{0}
+    {
+        allocate(capacity);
+    }
+    
+    TabuList(const TabuList&) = default;
+    TabuList(TabuList&&) = default;
+    
+    TabuList& operator=(const TabuList&) = default;
+    TabuList& operator=(TabuList&&) = default;
+    
+    size_t getCapacity() const noexcept { return slots_.size(); }
+    
+    void clear() noexcept
+    {
+        std::fill(slots_.begin(), slots_.end(), Slot{emptyKey, 0});
+        occupiedSlots_ = 0;
+    }
+    
+    bool isTabu(IdType node1, IdType node2, size_t iteration) const noexcept
+    {
+        uint64_t key = keyOf(node1, node2);
+        
+        for(size_t slot = slotOf(key); slots_[slot].key != emptyKey; slot = (slot + 1) & (slots_.size() - 1))
+        {
+            if(slots_[slot].key == key)
+            {
+                return slots_[slot].expiry > iteration;
+            }
+        }
+        
+        return false;
+    }
+    
+    // Forbids the edge until 'iteration + tenure', excluded
+    void add(IdType node1, IdType node2, size_t iteration, size_t tenure)
+    {
+        if(2 * (occupiedSlots_ + 1) > slots_.size())
+        {
+            rebuild(iteration);
+        }
+        
+        uint64_t key = keyOf(node1, node2);
+        size_t slot = slotOf(key);
+        
+        while(slots_[slot].key != emptyKey && slots_[slot].key != key)
+        {
+            slot = (slot + 1) & (slots_.size() - 1);
+        }
+        
+        occupiedSlots_ += slots_[slot].key == emptyKey ? 1 : 0;
+        slots_[slot] = {key, iteration + tenure};
+    }
+    
+    private:
+    struct Slot
+    {
+        uint64_t key;
+        size_t expiry;
+    };
+    
+    static constexpr uint64_t emptyKey = std::numeric_limits<uint64_t>::max();
+    
+    // Edges are undirected
+    static uint64_t keyOf(IdType node1, IdType node2) noexcept
+    {
+        return (uint64_t{std::min(node1, node2)} << 32) | std::max(node1, node2);
+    }
+    
+    size_t slotOf(uint64_t key) const noexcept
+    {
+        return static_cast<size_t>((key * 0x9e3779b97f4a7c15) >> shift_);
+    }
+    
+    // Capacity rounded up to a power of two, at least 2
+    void allocate(size_t capacity)
+    {
+        size_t size = 2;
+        shift_ = 63;
+        
+        while(size < capacity)
+        {
+            size *= 2;
+            --shift_;
+        }
+        
+        slots_.assign(size, Slot{emptyKey, 0});
+        occupiedSlots_ = 0;
+    }
+    
+    void rebuild(size_t iteration)
+    {
+        std::vector<Slot> live;
+        
+        for(const Slot& slot : slots_)
+        {
+            if(slot.key != emptyKey && slot.expiry > iteration)
+            {
+                live.push_back(slot);
+            }
+        }
+        
+        allocate(4 * (live.size() + 1) > slots_.size() ? 2 * slots_.size() : slots_.size());
+        
+        for(const Slot& entry : live)
+        {
+            size_t slot = slotOf(entry.key);
+            
+            while(slots_[slot].key != emptyKey)
+            {
+                slot = (slot + 1) & (slots_.size() - 1);
+            }
+            
+            slots_[slot] = entry;
+            ++occupiedSlots_;
+        }
+    }
+    
+    std::vector<Slot> slots_;
+    unsigned int shift_;
+    size_t occupiedSlots_;
+};
+
+}
+
+#endif // TABU_LIST_HXX
@@ -0,0 +1,349 @@
+#ifndef TABU_SEARCH_CVRP_SOLVER_HXX
+#define TABU_SEARCH_CVRP_SOLVER_HXX
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ActiveCustomerQueue.hxx>
+#include <AnytimeSolverSettings.hxx>
+#include <BestSolutionRecorder.hxx>
+#include <CandidateLists.hxx>
+#include <CapacityPenaltyController.hxx>
+#include <CVRPInstance.hxx>
+#include <CVRPSolution.hxx>
+#include <GenericCVRPSolver.hxx>
+#include <NeighbourhoodSearchSettings.hxx>
+#include <RandomEngine.hxx>
+#include <SearchSolution.hxx>
+#include <TabuList.hxx>
+#include <TimeBudget.hxx>
+
+namespace Solver
+{
+
+// Tabu search over the neighbourhoods : each iteration moves to the best admissible neighbour, even if it is worse
+// than the current solution. The attributes are edges : once a move removes an edge, recreating it is tabu for a tenure
+// drawn uniformly in [minTenure, maxTenure], and a move creating a tabu edge is only admissible if it leads to a
+// feasible solution shorter than the best one (aspiration).
+// An iteration enumerates the moves involving the next 'customersPerIteration' customers of a shuffled order, and keeps
+// the 'keptMoves' cheapest ones. Enumerating the moves around a customer costs tens of microseconds with candidate
+// lists, so a window of a few customers keeps iterations below the millisecond on large instances, while still
+// covering every customer each n / customersPerIteration iterations. They are then applied in order of cost until one is
+// admissible : the edges a move creates and removes are read from the customers the solution activates when applying
+// it, and a tabu move is undone. With candidate lists attached, the neighbourhoods only enumerate granular moves.
+template<class BaseSolver, class ... Neighbourhoods>
+class TabuSearchCVRPSolver : public GenericCVRPSolver<TabuSearchCVRPSolver<BaseSolver, Neighbourhoods...>>,
+                             public AnytimeSolverSettings,
+                             public NeighbourhoodSearchSettings
+{
+    private:
+    using CVRPInstance = Data::CVRPInstance;
+    using IdType = Heuristic::SearchSolution::IdType;
+    using NeighbourhoodTupleType = std::tuple<Neighbourhoods...>;
+    using MoveVariantType = std::variant<typename Neighbourhoods::Move...>;
+    using AdjacencyType = std::array<IdType, 2>;
+    
+    struct CandidateMove
+    {
+        double cost;
+        MoveVariantType move;
+    };
+    
+    public:
+    static constexpr size_t defaultMinTenure = 10;
+    static constexpr size_t defaultMaxTenure = 25;
+    static constexpr size_t defaultCustomersPerIteration = 16;
+    static constexpr size_t keptMoves = 8;
+    
+    public:
+    TabuSearchCVRPSolver(const BaseSolver& baseSolver,
+                         size_t iterations,
+                         double wrongCapacityPenalty = CVRPSolutionCostProcessor::defaultWrongCapacityPenalty,
+                         double repairCapacityPenalty = defaultRepairCapacityPenalty)
+    : TabuSearchCVRPSolver(baseSolver, iterations, CapacityPenaltyController{wrongCapacityPenalty}, repairCapacityPenalty)
+    {}
+    
+    TabuSearchCVRPSolver(const BaseSolver& baseSolver,
+                         size_t iterations,
+                         const CapacityPenaltyController& penaltyController,
+                         double repairCapacityPenalty = defaultRepairCapacityPenalty)
+    : GenericCVRPSolver<TabuSearchCVRPSolver>(),
+      AnytimeSolverSettings(),
+      NeighbourhoodSearchSettings(repairCapacityPenalty),
+      baseSolver_{baseSolver},
+      iterations_{iterations},
+      penaltyController_{penaltyController},
+      minTenure_{defaultMinTenure},
+      maxTenure_{defaultMaxTenure},
+      customersPerIteration_{defaultCustomersPerIteration},
+      neighbourhoods_{},
+      tabuList_{},
+      touchedCustomers_{0},
+      touched_{},
+      adjacency_{},
+      performedIterations_{0}
+    {}
+    
+    void setTenure(size_t minTenure, size_t maxTenure) noexcept
+    {
+        minTenure_ = minTenure;
+        maxTenure_ = std::max(minTenure, maxTenure);
+    }
+    
+    size_t getMinTenure() const noexcept { return minTenure_; }
+    size_t getMaxTenure() const noexcept { return maxTenure_; }
+    
+    // Zero makes every iteration enumerate the moves involving all the customers
+    void setCustomersPerIteration(size_t customersPerIteration) noexcept
+    {
+        customersPerIteration_ = customersPerIteration;
+    }
+    
+    size_t getCustomersPerIteration() const noexcept
+    {
+        return customersPerIteration_;
+    }
+    
+    // Number of iterations of the last run
+    size_t getPerformedIterations() const noexcept
+    {
+        return performedIterations_;
+    }
+    
+    CVRPSolution solve(const CVRPInstance& instance)
+    {
+        Heuristic::RandomEngine randomEngine = startRandomEngine();
+        
+        auto origSol = baseSolver_.solve(instance);
+        auto penaltyController = penaltyController_;
+        CVRPSolution::CostProcessor costProcessor{penaltyController.getPenalty()};
+        Heuristic::SearchSolution solution{instance, origSol.getData()};
+        
+        Heuristic::CandidateLists candidateLists = createCandidateLists(instance);
+        configure(solution, candidateLists);
+        
+        std::vector<IdType> order(solution.getRoutes().customers(), solution.getRoutes().customers() + solution.getNumberOfCustomers());
+        std::shuffle(order.begin(), order.end(), randomEngine);
+        size_t customersPerIteration = customersPerIteration_ == 0 ? order.size() : std::min(customersPerIteration_, order.size());
+        size_t nextCustomer = 0;
+        
+        tabuList_.clear();
+        touchedCustomers_ = Heuristic::ActiveCustomerQueue{instance.getNumberOfNodes()};
+        adjacency_.assign(instance.getNumberOfNodes(), AdjacencyType{solution.getDepot(), solution.getDepot()});
+        for(IdType customer : order)
+        {
+            adjacency_[customer] = adjacencyOf(solution, customer);
+        }
+        
+        TimeBudget timeBudget = startTimeBudget();
+        BestSolutionRecorder best{instance, getBestSolutionCallback()};
+        best.record(solution);
+        
+        std::vector<CandidateMove> candidates;
+        candidates.reserve(keptMoves);
+        std::uniform_int_distribution<size_t> tenurePicker(minTenure_, maxTenure_);
+        
+        for(performedIterations_ = 0; performedIterations_ < iterations_ && !timeBudget.isExhausted() && !order.empty(); ++performedIterations_)
+        {
+            candidates.clear();
+            
+            for(size_t i = 0; i < customersPerIteration; ++i)
+            {
+                collectMoves(solution, costProcessor, order[nextCustomer], candidates, std::index_sequence_for<Neighbourhoods...>{});
+                nextCustomer = nextCustomer + 1 == order.size() ? 0 : nextCustomer + 1;
+            }
+            
+            for(const CandidateMove& candidate : candidates)
+            {
+                if(tryMove(solution, candidate.move, best.getDistance(), tenurePicker(randomEngine), std::index_sequence_for<Neighbourhoods...>{}))
+                {
+                    break;
+                }
+            }
+            
+            if(penaltyController.recordMove(solution.isFeasible()))
+            {
+                penaltyController.applyTo(costProcessor);
+            }
+            
+            best.record(solution);
+        }
+        
+        // Without any feasible solution found, the current one is repaired with a penalised descent on the kept moves
+        if(!best.hasSolution())
+        {
+            getRepairPenaltyController().applyTo(costProcessor);
+            
+            for(bool improved = true; improved && !solution.isFeasible() && !timeBudget.isExhausted();)
+            {
+                double currentCost = solution.getCost(costProcessor);
+                candidates.clear();
+                
+                for(IdType customer : order)
+                {
+                    collectMoves(solution, costProcessor, customer, candidates, std::index_sequence_for<Neighbourhoods...>{});
+                }
+                
+                improved = !candidates.empty() && candidates.front().cost < currentCost;
+                if(improved)
+                {
+                    applyMove(solution, candidates.front().move, std::index_sequence_for<Neighbourhoods...>{});
+                }
+            }
+            
+            return {instance, solution.toSolutionData()};
+        }
+        
+        return best.toSolution();
+    }
+    
+    private:
+    static AdjacencyType adjacencyOf(const Heuristic::SearchSolution& solution, IdType customer) noexcept
+    {
+        size_t route = solution.routeOf(customer);
+        size_t position = solution.positionOf(customer);
+        
+        return {solution.predecessorOf(route, position), solution.successorOf(route, position)};
+    }
+    
+    static bool isAdjacent(const AdjacencyType& adjacency, IdType node) noexcept
+    {
+        return adjacency[0] == node || adjacency[1] == node;
+    }
+    
+    // Keeps the moves involving the customer among the 'keptMoves' cheapest ones, sorted by increasing cost
+    template<size_t ... indices>
+    void collectMoves(const Heuristic::SearchSolution& solution, const CVRPSolutionCostProcessor& costProcessor, IdType customer,
+                      std::vector<CandidateMove>& candidates, std::index_sequence<indices...>) const
+    {
+        (collectMovesIn<indices>(solution, costProcessor, customer, candidates), ...);
+    }
+    
+    template<size_t index>
+    void collectMovesIn(const Heuristic::SearchSolution& solution, const CVRPSolutionCostProcessor& costProcessor, IdType customer,
+                        std::vector<CandidateMove>& candidates) const
+    {
+        const auto& neighbourhood = std::get<index>(neighbourhoods_);
+        using MoveType = typename std::tuple_element_t<index, NeighbourhoodTupleType>::Move;
+        
+        neighbourhood.forEachMove(solution, customer, [&](const MoveType& move)
+        {
+            auto evaluation = neighbourhood.evaluate(solution, move);
+            double cost = costProcessor.computeCost(solution.getDistance() + evaluation.distanceDelta, evaluation.excessLoad);
+            
+            if(candidates.size() == keptMoves && !(cost < candidates.back().cost))
+            {
+                return false;
+            }
+            
+            if(candidates.size() < keptMoves)
+            {
+                candidates.push_back({cost, MoveVariantType{std::in_place_index<index>, move}});
+            }
+            else
+            {
+                candidates.back() = {cost, MoveVariantType{std::in_place_index<index>, move}};
+            }
+            
+            for(size_t rank = candidates.size() - 1; rank > 0 && candidates[rank].cost < candidates[rank - 1].cost; --rank)
+            {
+                std::swap(candidates[rank], candidates[rank - 1]);
+            }
+            
+            return false;
+        });
+    }
+    
+    template<size_t ... indices>
+    void applyMove(Heuristic::SearchSolution& solution, const MoveVariantType& move, std::index_sequence<indices...>) const
+    {
+        ((move.index() == indices ? std::get<indices>(neighbourhoods_).apply(solution, std::get<indices>(move)) : void()), ...);
+    }
+    
+    template<size_t ... indices>
+    void undoMove(Heuristic::SearchSolution& solution, const MoveVariantType& move, std::index_sequence<indices...>) const
+    {
+        ((move.index() == indices ? std::get<indices>(neighbourhoods_).undo(solution, std::get<indices>(move)) : void()), ...);
+    }
+    
+    // Applies the move, and keeps it if it is admissible : it changes the solution, and it creates no tabu edge or
+    // leads to a new best solution. The edges it removes then become tabu.
+    template<size_t ... indices>
+    bool tryMove(Heuristic::SearchSolution& solution, const MoveVariantType& move, double bestDistance, size_t tenure, std::index_sequence<indices...> sequence)
+    {
+        solution.setActiveCustomers(&touchedCustomers_);
+        applyMove(solution, move, sequence);
+        solution.setActiveCustomers(nullptr);
+        
+        touched_.clear();
+        while(!touchedCustomers_.empty())
+        {
+            touched_.push_back(touchedCustomers_.pop());
+        }
+        
+        bool changed = false;
+        bool tabu = false;
+        
+        for(IdType customer : touched_)
+        {
+            for(IdType node : adjacencyOf(solution, customer))
+            {
+                if(!isAdjacent(adjacency_[customer], node))
+                {
+                    changed = true;
+                    tabu = tabu || tabuList_.isTabu(customer, node, performedIterations_);
+                }
+            }
+        }
+        
+        bool aspiration = solution.isFeasible() && solution.getDistance() < bestDistance;
+        
+        if(!changed || (tabu && !aspiration))
+        {
+            undoMove(solution, move, sequence);
+            return false;
+        }
+        
+        for(IdType customer : touched_)
+        {
+            for(IdType node : adjacency_[customer])
+            {
+                if(!isAdjacent(adjacencyOf(solution, customer), node))
+                {
+                    tabuList_.add(customer, node, performedIterations_, tenure);
+                }
+            }
+        }
+        
+        for(IdType customer : touched_)
+        {
+            adjacency_[customer] = adjacencyOf(solution, customer);
+        }
+        
+        return true;
+    }
+    
+    BaseSolver baseSolver_;
+    size_t iterations_;
+    CapacityPenaltyController penaltyController_;
+    size_t minTenure_;
+    size_t maxTenure_;
+    size_t customersPerIteration_;
+    NeighbourhoodTupleType neighbourhoods_;
+    
+    // State of the current run
+    Heuristic::TabuList tabuList_;
+    Heuristic::ActiveCustomerQueue touchedCustomers_;
+    std::vector<IdType> touched_;
+    std::vector<AdjacencyType> adjacency_;
+    size_t performedIterations_;
+};
+
+}
+
+#endif // TABU_SEARCH_CVRP_SOLVER_HXX
@@ -0,0 +1,98 @@
+#ifndef TIME_BUDGET_HXX
+#define TIME_BUDGET_HXX
+
+#include <algorithm>
+#include <chrono>
+
+namespace Solver
+{
+
+// Wall-clock budget of a heuristic run, unlimited by default.
+// Reading the clock costs about as much as evaluating a move, so 'isExhausted' only reads it once every 'checkPeriod'
+// calls, and keeps answering true once the deadline has passed.
+class TimeBudget
+{
+    public:
+    using ClockType = std::chrono::steady_clock;
+    
+    static constexpr size_t defaultCheckPeriod = 256;
+    
+    public:
+    TimeBudget() noexcept
+    : TimeBudget(ClockType::duration::max())
+    {}
+    
+    template<class Rep, class Period>
+    explicit TimeBudget(std::chrono::duration<Rep, Period> budget, size_t checkPeriod = defaultCheckPeriod) noexcept
+    : budget_{std::chrono::duration_cast<ClockType::duration>(budget)},
+      checkPeriod_{std::max(checkPeriod, size_t{1})},
+      start_{},
+      deadline_{ClockType::time_point::max()},
+      callsBeforeCheck_{checkPeriod_},
+      exhausted_{false}
+    {}
+    
+    TimeBudget(const TimeBudget&) = default;
+    TimeBudget(TimeBudget&&) = default;
+    
+    TimeBudget& operator=(const TimeBudget&) = default;
+    TimeBudget& operator=(TimeBudget&&) = default;
+    
+    bool isUnlimited() const noexcept { return budget_ == ClockType::duration::max(); }
+    ClockType::duration getBudget() const noexcept { return budget_; }
+    size_t getCheckPeriod() const noexcept { return checkPeriod_; }
+    
+    // Starts counting the budget from now
+    void start() noexcept
+    {
+        start_ = ClockType::now();
+        deadline_ = isUnlimited() || ClockType::time_point::max() - start_ < budget_ ? ClockType::time_point::max() : start_ + budget_;
+        callsBeforeCheck_ = checkPeriod_;
+        exhausted_ = false;
+    }
+    
+    bool isExhausted() noexcept
+    {
+        if(exhausted_ || deadline_ == ClockType::time_point::max())
+        {
+            return exhausted_;
+        }
+        
+        if(--callsBeforeCheck_ != 0)
+        {
+            return false;
+        }
+        
+        callsBeforeCheck_ = checkPeriod_;
+        exhausted_ = ClockType::now() >= deadline_;
+        return exhausted_;
+    }
+    
+    double getElapsedSeconds() const noexcept
+    {
+        return std::chrono::duration<double>(ClockType::now() - start_).count();
+    }
+    
+    // Fraction of the budget used since the start, 0 for an unlimited budget
+    double getElapsedFraction() const noexcept
+    {
+        if(isUnlimited())
+        {
+            return 0.0;
+        }
+        
+        return std::min(getElapsedSeconds() / std::chrono::duration<double>(budget_).count(), 1.0);
+    }
+    
+    private:
+    ClockType::duration budget_;
+    size_t checkPeriod_;
+    ClockType::time_point start_;
+    ClockType::time_point deadline_;
+    size_t callsBeforeCheck_;
+    bool exhausted_;
+};
+
+}
+
+#endif // TIME_BUDGET_HXX
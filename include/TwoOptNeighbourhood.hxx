@@ -0,0 +1,125 @@
+#ifndef TWO_OPT_NEIGHBOURHOOD_HXX
+#define TWO_OPT_NEIGHBOURHOOD_HXX
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// Intra-route 2-opt : a segment of a route is reversed in place. The route keeps its load, and only the two
+// edges at the ends of the segment change, so evaluating a move is constant time.
+// This lets the descent keep optimising the order of the routes, instead of relying on the TSP solver
+// only once, at the construction of the initial solution.
+class TwoOptNeighbourhood : public GenericNeighbourhoodGenerator<TwoOptNeighbourhood>
+{
+    public:
+    // The reversed segment is [begin, end), and holds at least two customers
+    struct Move
+    {
+        size_t route;
+        size_t begin;
+        size_t end;
+    };
+    
+    // The segment between the customer and its candidate is reversed, so that the one coming first is followed by the other
+    static constexpr size_t granularVariants = 1;
+    
+    static constexpr const char* name = "2-opt";
+    
+    public:
+    using GenericNeighbourhoodGenerator::GenericNeighbourhoodGenerator;
+    
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        if(solution.isGranular())
+        {
+            return randomGranularMove(solution, randomEngine, move);
+        }
+        
+        if(solution.getNumberOfRoutes() == 0)
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> routePicker(0, solution.getNumberOfRoutes() - 1);
+        move.route = routePicker(randomEngine);
+        
+        size_t size = solution.getRouteSize(move.route);
+        if(size < 2)
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> positionPicker1(0, size - 1);
+        std::uniform_int_distribution<size_t> positionPicker2(0, size - 2);
+        move.begin = positionPicker1(randomEngine);
+        move.end = positionPicker2(randomEngine);
+        move.end += move.end >= move.begin ? 1 : 0;
+        
+        if(move.begin > move.end)
+        {
+            std::swap(move.begin, move.end);
+        }
+        ++move.end;
+        
+        return true;
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        return {solution.reversalDelta(move.route, move.begin, move.end), solution.getExcessLoad()};
+    }
+    
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.reverse(move.route, move.begin, move.end);
+    }
+    
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        apply(solution, move);
+    }
+    
+    // Segments starting with the customer
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor&& visitor) const
+    {
+        if(solution.isGranular())
+        {
+            return forEachGranularMove(solution, customer, visitor);
+        }
+        
+        Move move;
+        move.route = solution.routeOf(customer);
+        move.begin = solution.positionOf(customer);
+        
+        for(move.end = move.begin + 2; move.end <= solution.getRouteSize(move.route); ++move.end)
+        {
+            if(visitor(move))
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    bool granularMove(const SearchSolution& solution, SearchSolution::IdType customer, SearchSolution::IdType candidate, size_t, Move& move) const noexcept
+    {
+        move.route = solution.routeOf(customer);
+        move.begin = std::min(solution.positionOf(customer), solution.positionOf(candidate)) + 1;
+        move.end = std::max(solution.positionOf(customer), solution.positionOf(candidate)) + 1;
+        
+        return solution.routeOf(customer) == solution.routeOf(candidate) && move.end - move.begin >= 2;
+    }
+};
+
+}
+
+#endif // TWO_OPT_NEIGHBOURHOOD_HXX
@@ -0,0 +1,122 @@
+#ifndef TWO_OPT_STAR_NEIGHBOURHOOD_HXX
+#define TWO_OPT_STAR_NEIGHBOURHOOD_HXX
+
+#include <random>
+
+#include <GenericNeighbourhoodGenerator.hxx>
+#include <SearchSolution.hxx>
+
+namespace Heuristic
+{
+
+// Inter-route 2-opt* : the tails of two routes, starting at the given positions, are exchanged.
+// Only the two edges at the cuts change, and the new loads come from the prefix loads, so evaluating
+// a move is constant time, and nothing is copied.
+class TwoOptStarNeighbourhood : public GenericNeighbourhoodGenerator<TwoOptStarNeighbourhood>
+{
+    public:
+    // Positions range from 0 (the whole route is the tail) to the route size (the tail is empty)
+    struct Move
+    {
+        size_t route1;
+        size_t position1;
+        size_t route2;
+        size_t position2;
+    };
+    
+    // The tail starting with the customer is appended right after its candidate
+    static constexpr size_t granularVariants = 1;
+    
+    static constexpr const char* name = "2-opt*";
+    
+    public:
+    using GenericNeighbourhoodGenerator::GenericNeighbourhoodGenerator;
+    
+    template<class RandomEngine>
+    bool randomMove(const SearchSolution& solution, RandomEngine& randomEngine, Move& move) const
+    {
+        if(solution.isGranular())
+        {
+            return randomGranularMove(solution, randomEngine, move);
+        }
+        
+        if(!pickTwoRoutes(solution, randomEngine, move.route1, move.route2) || solution.canSkipRoutePair(move.route1, move.route2))
+        {
+            return false;
+        }
+        
+        std::uniform_int_distribution<size_t> positionPicker1(0, solution.getRouteSize(move.route1));
+        std::uniform_int_distribution<size_t> positionPicker2(0, solution.getRouteSize(move.route2));
+        move.position1 = positionPicker1(randomEngine);
+        move.position2 = positionPicker2(randomEngine);
+        
+        return true;
+    }
+    
+    MoveEvaluation evaluate(const SearchSolution& solution, const Move& move) const noexcept
+    {
+        size_t size1 = solution.getRouteSize(move.route1);
+        size_t size2 = solution.getRouteSize(move.route2);
+        
+        return {solution.segmentSwapDelta(move.route1, move.position1, size1, move.route2, move.position2, size2),
+                solution.segmentSwapExcessLoad(move.route1, move.position1, size1, move.route2, move.position2, size2)};
+    }
+    
+    void apply(SearchSolution& solution, const Move& move) const noexcept
+    {
+        solution.swapSegments(move.route1, move.position1, solution.getRouteSize(move.route1),
+                              move.route2, move.position2, solution.getRouteSize(move.route2));
+    }
+    
+    // The heads keep their length, so exchanging the tails at the same positions again restores the routes
+    void undo(SearchSolution& solution, const Move& move) const noexcept
+    {
+        apply(solution, move);
+    }
+    
+    // The tail starting with the customer, exchanged with every tail of every other route
+    template<class Visitor>
+    bool forEachMove(const SearchSolution& solution, SearchSolution::IdType customer, Visitor&& visitor) const
+    {
+        if(solution.isGranular())
+        {
+            return forEachGranularMove(solution, customer, visitor);
+        }
+        
+        Move move;
+        move.route1 = solution.routeOf(customer);
+        move.position1 = solution.positionOf(customer);
+        
+        for(move.route2 = 0; move.route2 < solution.getNumberOfRoutes(); ++move.route2)
+        {
+            if(move.route2 == move.route1 || solution.canSkipRoutePair(move.route1, move.route2))
+            {
+                continue;
+            }
+            
+            for(move.position2 = 0; move.position2 <= solution.getRouteSize(move.route2); ++move.position2)
+            {
+                if(visitor(move))
+                {
+                    return true;
+                }
+            }
+        }
+        
+        return false;
+    }
+    
+    bool granularMove(const SearchSolution& solution, SearchSolution::IdType customer, SearchSolution::IdType candidate, size_t, Move& move) const noexcept
+    {
+        move.route1 = solution.routeOf(customer);
+        move.position1 = solution.positionOf(customer);
+        move.route2 = solution.routeOf(candidate);
+        move.position2 = solution.positionOf(candidate) + 1;
+        
+        return move.route1 != move.route2;
+    }
+};
+
+}
+
+#endif // TWO_OPT_STAR_NEIGHBOURHOOD_HXX
@@ -11,7 +11,14 @@
 #include <SolutionLoader.hxx>
 #include <StochasticDescentCVRPSolver.hxx>
 #include <TVRPInstance.hxx>
+#include <CrossExchangeNeighbourhood.hxx>
+#include <EjectionChainNeighbourhood.hxx>
 #include <OnePointExtraNeighbourhood.hxx>
+#include <OrOptNeighbourhood.hxx>
+#include <SwapNeighbourhood.hxx>
+#include <SwapStarNeighbourhood.hxx>
+#include <TwoOptNeighbourhood.hxx>
+#include <TwoOptStarNeighbourhood.hxx>
 #include <AggTVRPSolver.hxx>
 #include <CutCVRPSolver.hxx>
 
@@ -131,7 +138,9 @@ int main()
     // using FirstSolver = Solver::RouteAffectationBinPackingAdaptor<Solver::BinPackingMIPSolver>;
     using FirstSolver = Solver::SweepRouteAffectationSolver;
     Solver::TwoStepsCVRPSolver<FirstSolver, Solver::TwoOptTSPSolver> solver4({inst}, {});
-    Solver::StochasticDescentCVRPSolver<Solver::TwoStepsCVRPSolver<FirstSolver, Solver::TwoOptTSPSolver>, Heuristic::OnePointExtraNeighbourhood> stochSolv{solver4, 100000};
+    Solver::StochasticDescentCVRPSolver<Solver::TwoStepsCVRPSolver<FirstSolver, Solver::TwoOptTSPSolver>, Heuristic::OnePointExtraNeighbourhood, Heuristic::TwoOptStarNeighbourhood,
+                                        Heuristic::SwapNeighbourhood, Heuristic::CrossExchangeNeighbourhood<>, Heuristic::OrOptNeighbourhood<>,
+                                        Heuristic::TwoOptNeighbourhood, Heuristic::SwapStarNeighbourhood, Heuristic::EjectionChainNeighbourhood<>> stochSolv{solver4, 100000};
     auto sol4 = solver4.solve(inst);
     std::cout << sol4.computeCost() << std::endl;
     auto sol5 = stochSolv.solve(inst);